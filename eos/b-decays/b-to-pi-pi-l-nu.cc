@@ -27,6 +27,9 @@
 
 #include <gsl/gsl_monte.h>
 #include <gsl/gsl_monte_miser.h>
+#include <gsl/gsl_rng.h>
+
+#include <memory>
 
 namespace eos
 {
@@ -49,11 +52,6 @@ namespace eos
 
         UsedParameter hbar;
 
-        // GSL elements for MC integration
-        gsl_rng * rng;
-        gsl_monte_function normalized_decay_width_integrand;
-        gsl_monte_miser_state * state;
-
         static const std::vector<OptionSpecification> options;
 
         Implementation(const Parameters & p, const Options & o, ParameterUser & u) :
@@ -64,9 +62,7 @@ namespace eos
             m_pi(p["mass::pi^" + std::string(o.get("q", "d") == "d" ? "+" : "0")], u),
             m_l(p["mass::" + o.get("l", "mu")], u),
             g_fermi(p["WET::G_Fermi"], u),
-            hbar(p["QM::hbar"], u),
-            rng(gsl_rng_alloc(gsl_rng_mt19937)),
-            state(gsl_monte_miser_alloc(3u))
+            hbar(p["QM::hbar"], u)
         {
             if (o.get("l", "mu") == "tau")
             {
@@ -85,8 +81,30 @@ namespace eos
 
         ~Implementation()
         {
-            gsl_monte_miser_free(state);
-            gsl_rng_free(rng);
+        }
+
+        /*
+         * Integrate the normalized differential decay width with MISER.
+         *
+         * The random number generator and the MISER state are created for each integration. This decay
+         * might be shared among several observables, which the ObservableCache evaluates concurrently,
+         * and each result must not depend on the integrations carried out for other observables.
+         */
+        double integrate_normalized_decay_width(const double * x_min, const double * x_max) const
+        {
+            // Yields a numerical error of approximately 0.2%.
+            static const size_t calls = 50000;
+
+            std::unique_ptr<gsl_rng, decltype(&gsl_rng_free)> rng(gsl_rng_alloc(gsl_rng_mt19937), &gsl_rng_free);
+            std::unique_ptr<gsl_monte_miser_state, decltype(&gsl_monte_miser_free)> state(gsl_monte_miser_alloc(3u), &gsl_monte_miser_free);
+
+            gsl_monte_function integrand{ &normalized_differential_decay_width_gsl_adapter, 3u, const_cast<void *>(reinterpret_cast<const void *>(this)) };
+
+            double result, error;
+
+            gsl_monte_miser_integrate(&integrand, x_min, x_max, 3u, calls, rng.get(), state.get(), &result, &error);
+
+            return result;
         }
 
         // normalized to V_ub = 1
@@ -146,39 +164,22 @@ namespace eos
                 const double k2min, const double & k2max,
                 const double & zmin, const double & zmax) const
         {
-            // Yields a numerical error of approximately 0.2%.
-            static const size_t calls = 50000;
-
             const double x_min[3] = { q2min, k2min, zmin };
             const double x_max[3] = { q2max, k2max, zmax };
 
-            gsl_monte_function integrand{ &normalized_differential_decay_width_gsl_adapter, 3u, const_cast<void *>(reinterpret_cast<const void *>(this)) };
-
-            double result, error;
-
-            gsl_monte_miser_integrate(&integrand, x_min, x_max, 3u, calls, rng, state, &result, &error);
-
-            return result;
+            return integrate_normalized_decay_width(x_min, x_max);
         }
 
         double normalized_integrated_forward_backward_asymmetry(const double & q2min, const double & q2max,
                 const double k2min, const double & k2max) const
         {
-            // Yields a numerical error of approximately 0.2%.
-            static const size_t calls = 50000;
-
             const double x_forward_min[3]  = { q2min, k2min,  0.0 };
             const double x_forward_max[3]  = { q2max, k2max, +1.0 };
             const double x_backward_min[3] = { q2min, k2min, -1.0 };
             const double x_backward_max[3] = { q2max, k2max,  0.0 };
 
-            gsl_monte_function integrand{ &normalized_differential_decay_width_gsl_adapter, 3u, const_cast<void *>(reinterpret_cast<const void *>(this)) };
-
-            double forward,  forward_error;
-            double backward, backward_error;
-
-            gsl_monte_miser_integrate(&integrand, x_forward_min, x_forward_max, 3u, calls, rng, state, &forward, &forward_error);
-            gsl_monte_miser_integrate(&integrand, x_backward_min, x_backward_max, 3u, calls, rng, state, &backward, &backward_error);
+            const double forward  = integrate_normalized_decay_width(x_forward_min,  x_forward_max);
+            const double backward = integrate_normalized_decay_width(x_backward_min, x_backward_max);
 
             return (forward - backward) / (forward + backward);
         }
@@ -67,5 +67,41 @@ class BToPiPiLeptonNeutrinoTest :
                 TEST_CHECK_RELATIVE_ERROR(d.integrated_forward_backward_asymmetry(0.02, 0.95, 18.60, 26.40), -0.22715,       eps);
                 TEST_CHECK_RELATIVE_ERROR(d.integrated_forward_backward_asymmetry(0.02, 1.95, 15.00, 26.40), -0.10447,       eps);
             }
+
+            // Observables sharing one decay yield the same results as observables using separate decays
+            {
+                Parameters p = Parameters::Defaults();
+                Options oo;
+                oo.declare("model", "CKM");
+                oo.declare("form-factors", "BFvD2016");
+
+                Kinematics k_br
+                {
+                    { "q2_min",  0.02 }, { "q2_max",  0.95 },
+                    { "k2_min", 18.60 }, { "k2_max", 26.40 },
+                    { "z_min",  -1.0  }, { "z_max",  +1.0  }
+                };
+                Kinematics k_afb
+                {
+                    { "q2_min",  0.02 }, { "q2_max",  0.95 },
+                    { "k2_min", 18.60 }, { "k2_max", 26.40 }
+                };
+
+                // separate decays
+                auto separate_br  = Observable::make("B->pipilnu::BR",   p,         k_br,  oo);
+                auto separate_afb = Observable::make("B->pipilnu::A_FB", p.clone(), k_afb, oo);
+                const double reference_br  = separate_br->evaluate();
+                const double reference_afb = separate_afb->evaluate();
+
+                // one shared decay, evaluated in interleaved order
+                Parameters q = p.clone();
+                auto shared_br  = Observable::make("B->pipilnu::BR",   q, k_br,  oo);
+                auto shared_afb = Observable::make("B->pipilnu::A_FB", q, k_afb, oo);
+
+                TEST_CHECK_EQUAL(reference_afb, shared_afb->evaluate());
+                TEST_CHECK_EQUAL(reference_br,  shared_br->evaluate());
+                TEST_CHECK_EQUAL(reference_afb, shared_afb->evaluate());
+                TEST_CHECK_EQUAL(reference_br,  shared_br->evaluate());
+            }
         }
 } b_to_pi_pi_l_nu_test;
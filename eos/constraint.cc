@@ -23,10 +23,13 @@
 #include <eos/maths/gsl-interface.hh>
 #include <eos/maths/power-of.hh>
 #include <eos/statistics/log-likelihood.hh>
+#include <eos/utils/database-image.hh>
 #include <eos/utils/destringify.hh>
 #include <eos/utils/exception.hh>
 #include <eos/utils/instantiation_policy-impl.hh>
+#include <eos/utils/lock.hh>
 #include <eos/utils/log.hh>
+#include <eos/utils/mutex.hh>
 #include <eos/utils/observable_set.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
 #include <eos/utils/qualified-name.hh>
@@ -38,7 +41,10 @@
 #include <yaml-cpp/yaml.h>
 
 #include <cmath>
+#include <functional>
 #include <map>
+#include <memory>
+#include <tuple>
 #include <vector>
 
 namespace fs = boost::filesystem;
@@ -2397,15 +2403,9 @@ namespace eos
         return std::bind(&Factory_::make, f, std::placeholders::_1, std::placeholders::_2);
     }
 
-    std::map<QualifiedName, std::shared_ptr<const ConstraintEntry>>
-    load_constraint_entries()
+    fs::path
+    constraints_base_directory()
     {
-        Context context("When loading constraint entries:");
-
-        using ValueType = std::map<QualifiedName, std::shared_ptr<const ConstraintEntry>>::value_type;
-
-        std::map<QualifiedName, std::shared_ptr<const ConstraintEntry>> result;
-
         fs::path base;
         if (std::getenv("EOS_TESTS_CONSTRAINTS"))
         {
@@ -2432,6 +2432,13 @@ namespace eos
             throw InternalError("Expect '" + base.string() + " to be a directory");
         }
 
+        return base;
+    }
+
+    // Calls the visitor with the file name, the key and the YAML node of every constraint entry in the input files.
+    void
+    visit_constraint_input_files(const fs::path & base, const std::function<void (const std::string &, const std::string &, const YAML::Node &)> & visitor)
+    {
         for (fs::directory_iterator f(base), f_end ; f != f_end ; ++f)
         {
             auto file_path = f->path();
@@ -2464,15 +2471,7 @@ namespace eos
                     if ("@metadata@" == keyname)
                         continue;
 
-                    Context context("When parsing constraint '" + keyname + "':");
-
-                    QualifiedName name(keyname);
-                    std::shared_ptr<const ConstraintEntry> entry{ ConstraintEntry::FromYAML(name, p.second) };
-
-                    if (! result.insert(ValueType{ name, entry }).second)
-                    {
-                        throw ConstraintInputFileParseError(file, "encountered duplicate constraint '" + keyname + "'");
-                    }
+                    visitor(file_path.filename().string(), keyname, p.second);
                 }
             }
             catch (ConstraintDeserializationError & e)
@@ -2480,33 +2479,142 @@ namespace eos
                 throw ConstraintInputFileParseError(file, e.what());
             }
         }
-
-        return result;
     }
 
+    /*
+     * Holds the known constraint entries.
+     *
+     * On construction, only an index of the entry names is built. Each entry is deserialized when it is first
+     * looked up, or when all entries are requested for iteration.
+     */
     class ConstraintEntries :
         public InstantiationPolicy<ConstraintEntries, Singleton>
     {
         private:
+            // The origin of an entry that has not been deserialized yet.
+            struct Source
+            {
+                std::string file;
+
+                // the position of the entry's node within the image, or its index within _nodes
+                std::size_t position;
+            };
+
+            Mutex _mutex;
+
+            std::shared_ptr<const DatabaseImage> _image;
+
+            std::vector<YAML::Node> _nodes;
+
+            std::map<QualifiedName, Source> _sources;
+
             std::map<QualifiedName, std::shared_ptr<const ConstraintEntry>> _entries;
 
-            ConstraintEntries() :
-                _entries(load_constraint_entries())
+            ConstraintEntries()
             {
+                Context context("When loading constraint entries:");
+
+                const fs::path base = constraints_base_directory();
+
+                auto add = [this] (const std::string & file, const std::string & keyname, const std::size_t & position)
+                {
+                    if (! _sources.insert(std::make_pair(QualifiedName(keyname), Source{ file, position })).second)
+                    {
+                        throw ConstraintInputFileParseError(file, "encountered duplicate constraint '" + keyname + "'");
+                    }
+                };
+
+                // prefer the precompiled image, unless it is missing or stale
+                _image = DatabaseImage::open((base / "constraints.eosdb").string(), DatabaseImage::fingerprint(base.string(), ".yaml"));
+                if (_image)
+                {
+                    // the index precedes the nodes, so that reading it touches only the beginning of the image
+                    auto cursor = _image->cursor();
+                    for (std::uint64_t i = 0, i_end = cursor.read_uint() ; i < i_end ; ++i)
+                    {
+                        const std::string file(cursor.read_string());
+                        const std::string keyname(cursor.read_string());
+                        add(file, keyname, cursor.read_uint());
+                    }
+                }
+                else
+                {
+                    visit_constraint_input_files(base, [this, &add] (const std::string & file, const std::string & keyname, const YAML::Node & node)
+                    {
+                        add(file, keyname, _nodes.size());
+                        _nodes.push_back(node);
+                    });
+                }
             }
 
             ~ConstraintEntries() = default;
 
+            // Deserializes an entry; requires _mutex to be locked.
+            std::shared_ptr<const ConstraintEntry> _load(const std::map<QualifiedName, Source>::iterator & s)
+            {
+                Context context("When parsing constraint '" + s->first.str() + "':");
+
+                std::shared_ptr<const ConstraintEntry> entry;
+                try
+                {
+                    YAML::Node node = _image ? _image->cursor(s->second.position).read_node() : _nodes[s->second.position];
+                    entry.reset(ConstraintEntry::FromYAML(s->first, node));
+                }
+                catch (ConstraintDeserializationError & e)
+                {
+                    throw ConstraintInputFileParseError(s->second.file, e.what());
+                }
+
+                _entries[s->first] = entry;
+                _sources.erase(s);
+
+                return entry;
+            }
+
         public:
             friend class InstantiationPolicy<ConstraintEntries, Singleton>;
 
-            const std::map<QualifiedName, std::shared_ptr<const ConstraintEntry>> & entries() const
+            std::shared_ptr<const ConstraintEntry> find(const QualifiedName & key)
             {
+                Lock l(_mutex);
+
+                auto e = _entries.find(key);
+                if (_entries.end() != e)
+                    return e->second;
+
+                auto s = _sources.find(key);
+                if (_sources.end() == s)
+                    return {};
+
+                return _load(s);
+            }
+
+            const std::map<QualifiedName, std::shared_ptr<const ConstraintEntry>> & entries()
+            {
+                Lock l(_mutex);
+
+                if (_sources.empty())
+                    return _entries;
+
+                Context context("When loading constraint entries:");
+
+                while (! _sources.empty())
+                {
+                    _load(_sources.begin());
+                }
+
+                // all entries have been deserialized, their sources are no longer needed
+                _image.reset();
+                _nodes.clear();
+
                 return _entries;
             }
 
             void insert(const QualifiedName & key, const std::shared_ptr<const ConstraintEntry> & value)
             {
+                Lock l(_mutex);
+
+                _sources.erase(key);
                 _entries[key] = value;
             }
     };
@@ -2514,13 +2622,12 @@ namespace eos
     Constraint
     Constraint::make(const QualifiedName & name, const Options & options)
     {
-        auto & entries = ConstraintEntries::instance()->entries();
-
-        auto e = entries.find(name);
-        if (e == entries.end())
+        auto entry = ConstraintEntries::instance()->find(name);
+        if (! entry)
             throw UnknownConstraintError(name);
 
-        return e->second->make(e->first, name.options() + options); // options supersede name.options
+        // the entry's name excludes the options
+        return entry->make(QualifiedName(name.prefix_part(), name.name_part(), name.suffix_part()), name.options() + options); // options supersede name.options
     }
 
     template <>
@@ -2533,12 +2640,6 @@ namespace eos
     template<>
     struct Implementation<Constraints>
     {
-        const std::map<QualifiedName, std::shared_ptr<const ConstraintEntry>> constraint_entries;
-
-        Implementation() :
-            constraint_entries(ConstraintEntries::instance()->entries())
-        {
-        }
     };
 
     Constraints::Constraints() :
@@ -2553,26 +2654,19 @@ namespace eos
     Constraints::ConstraintIterator
     Constraints::begin() const
     {
-        return ConstraintIterator(_imp->constraint_entries.cbegin());
+        return ConstraintIterator(ConstraintEntries::instance()->entries().cbegin());
     }
 
     Constraints::ConstraintIterator
     Constraints::end() const
     {
-        return ConstraintIterator(_imp->constraint_entries.cend());
+        return ConstraintIterator(ConstraintEntries::instance()->entries().cend());
     }
 
     std::shared_ptr<const ConstraintEntry>
     Constraints::operator[] (const QualifiedName & name) const
     {
-        auto i = _imp->constraint_entries.find(name);
-
-        if (_imp->constraint_entries.end() == i)
-        {
-            return {};
-        }
-
-        return i->second;
+        return ConstraintEntries::instance()->find(name);
     }
 
     std::shared_ptr<const ConstraintEntry>
@@ -2587,4 +2681,51 @@ namespace eos
 
         return _entry;
     }
+
+    void
+    Constraints::compile_image(const std::string & file)
+    {
+        Context context("When compiling the constraint entries:");
+
+        const fs::path base = constraints_base_directory();
+        const std::uint64_t fingerprint = DatabaseImage::fingerprint(base.string(), ".yaml");
+
+        std::map<QualifiedName, std::string> sources;
+        std::vector<std::tuple<std::string, std::string, YAML::Node>> entries;
+        visit_constraint_input_files(base, [&] (const std::string & source, const std::string & keyname, const YAML::Node & node)
+        {
+            Context context("When parsing constraint '" + keyname + "':");
+
+            // reject invalid and duplicate entries when compiling the image, rather than when loading it
+            QualifiedName name(keyname);
+            std::unique_ptr<const ConstraintEntry> entry(ConstraintEntry::FromYAML(name, node));
+
+            if (! sources.insert(std::make_pair(name, source)).second)
+            {
+                throw ConstraintInputFileParseError(source, "encountered duplicate constraint '" + keyname + "'");
+            }
+
+            entries.push_back(std::make_tuple(source, keyname, node));
+        });
+
+        // write the index first, followed by the nodes
+        DatabaseImageWriter writer;
+        writer.write_uint(entries.size());
+        std::vector<std::size_t> references;
+        for (const auto & [source, keyname, node] : entries)
+        {
+            writer.write_string(source);
+            writer.write_string(keyname);
+            references.push_back(writer.position());
+            writer.write_uint(0); // the position of the node, see below
+        }
+
+        auto r = references.cbegin();
+        for (const auto & [source, keyname, node] : entries)
+        {
+            writer.set_uint(*r++, writer.position());
+            writer.write_node(node);
+        }
+        writer.save(file, fingerprint);
+    }
 }
@@ -156,6 +156,7 @@ namespace eos
 
         ///@name Iteration over known constraints
         ///@{
+        /// Entries are deserialized lazily; iterating deserializes all remaining entries at once.
         struct ConstraintIteratorTag;
         using ConstraintIterator = WrappedForwardIterator<ConstraintIteratorTag, const std::pair<const QualifiedName, std::shared_ptr<const ConstraintEntry>>>;
 
@@ -166,6 +167,8 @@ namespace eos
         /*!
          * Retrieve a ConstraintEntry object by name.
          *
+         * The entry is deserialized upon its first retrieval. Returns nullptr for unknown names.
+         *
          * @param name  The name of the ConstraintEntry that shall be retrieved.
          */
         std::shared_ptr<const ConstraintEntry> operator[] (const QualifiedName & name) const;
@@ -176,6 +179,16 @@ namespace eos
          * @param entry A YAML-formatted string representing the new ConstraintEntry.
          */
         std::shared_ptr<const ConstraintEntry> insert(const QualifiedName & name, const std::string & entry) const;
+
+        /*!
+         * Compile the constraint input files into a binary database image.
+         *
+         * The constraint entries are loaded from the image 'constraints.eosdb' in the directory of the
+         * constraint input files in place of the input files, as long as the latter remain unchanged.
+         *
+         * @param file The name of the image file.
+         */
+        static void compile_image(const std::string & file);
     };
 
     extern template class WrappedForwardIterator<Constraints::ConstraintIteratorTag, const std::pair<const QualifiedName, std::shared_ptr<const ConstraintEntry>>>;
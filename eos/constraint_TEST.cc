@@ -1389,6 +1389,9 @@ class ConstraintTest :
                         TEST_CHECK_NO_THROW(c = constraints[n]);
                         TEST_CHECK(c.get() != nullptr);
                     }
+
+                    // unknown entries
+                    TEST_CHECK(constraints["B->pi::f_+@Unknown:2014A"].get() == nullptr);
                 }
                 catch (std::exception & e)
                 {
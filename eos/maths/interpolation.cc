@@ -25,7 +25,6 @@ namespace eos
     CSplineInterpolation::CSplineInterpolation(const std::vector<double> & data_x, const std::vector<double> & data_y):
         _data_x(data_x),
         _data_y(data_y),
-        _acc(gsl_interp_accel_alloc(), &gsl_interp_accel_free),
         _interp(gsl_interp_alloc(gsl_interp_cspline, _data_x.size()), &gsl_interp_free)
     {
         if (_data_x.size() != _data_y.size())
@@ -40,7 +39,7 @@ namespace eos
         double res = 0;
         int gsl_status = 0;
 
-        gsl_status = gsl_interp_eval_e(_interp.get(), &_data_x[0], &_data_y[0], x, _acc.get(), &res);
+        gsl_status = gsl_interp_eval_e(_interp.get(), &_data_x[0], &_data_y[0], x, nullptr, &res);
         if (gsl_status)
         {
             throw eos::GSLError(gsl_strerror(gsl_status));
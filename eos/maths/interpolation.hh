@@ -32,7 +32,6 @@ namespace eos
             const std::vector<double> _data_x;
             const std::vector<double> _data_y;
             const std::function<double(const double &)> _map_x;
-            const std::shared_ptr<gsl_interp_accel> _acc;
             const std::shared_ptr<gsl_interp> _interp;
 
         public:
@@ -48,6 +47,9 @@ namespace eos
             /*!
              * Evaluate the interpolating function.
              *
+             * No lookup accelerator is used, so that a shared interpolation
+             * can be evaluated concurrently.
+             *
              * @param x The point at which the function shall be evaluated.
              */
             double operator()(const double & x) const;
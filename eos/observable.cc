@@ -29,6 +29,7 @@
 #include <eos/utils/expression-observable.hh>
 #include <eos/utils/expression-parser-impl.hh>
 #include <eos/utils/instantiation_policy-impl.hh>
+#include <eos/utils/lock.hh>
 #include <eos/utils/log.hh>
 #include <eos/utils/observable_stub.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
@@ -43,32 +44,206 @@ namespace eos
     namespace impl
     {
         std::map<QualifiedName, ObservableEntryPtr> observable_entries;
-    }
 
-    ObservableEntries::ObservableEntries() :
-        _entries(&impl::observable_entries)
-    {
-        std::vector<std::function<ObservableSection ()>> section_makers = {
+        // the indices of the sections in observable_section_makers
+        enum ObservableSectionIndex : unsigned
+        {
+            form_factors = 0,
+            b_decays,
+            rare_b_decays,
+            meson_mixing
+        };
+
+        // in order of creation, if all sections are required
+        static const std::vector<ObservableSection (*)()> observable_section_makers
+        {
             make_form_factors_section,
             make_b_decays_section,
             make_rare_b_decays_section,
-            make_meson_mixing_section,
+            make_meson_mixing_section
+        };
+
+        // in order of presentation
+        static const std::vector<unsigned> observable_section_order
+        {
+            b_decays,
+            rare_b_decays,
+            meson_mixing,
+            form_factors
         };
 
-        for (const auto & section_maker : section_makers)
+        // the sections that provide observables with a given prefix
+        static const std::map<std::string, std::vector<unsigned>> observable_sections_by_prefix
         {
-            for (const auto & group : section_maker())
+            { "B", { form_factors, b_decays } },
+            { "B(_s)->D(_s)", { form_factors } },
+            { "B->D", { form_factors } },
+            { "B->D^*", { form_factors } },
+            { "B->D^*lnu", { b_decays } },
+            { "B->Dlnu", { b_decays } },
+            { "B->Dpilnu", { b_decays } },
+            { "B->K", { form_factors, rare_b_decays } },
+            { "B->K^*", { form_factors, rare_b_decays } },
+            { "B->K^*gamma", { rare_b_decays } },
+            { "B->K^*gamma^*", { rare_b_decays } },
+            { "B->K^*ll", { rare_b_decays } },
+            { "B->K^*nunu", { b_decays } },
+            { "B->K^*psi", { rare_b_decays } },
+            { "B->Kgamma^*", { rare_b_decays } },
+            { "B->Kll", { rare_b_decays } },
+            { "B->Knunu", { b_decays } },
+            { "B->Kpsi", { rare_b_decays } },
+            { "B->X_sgamma", { rare_b_decays } },
+            { "B->X_sll", { rare_b_decays } },
+            { "B->gamma", { form_factors } },
+            { "B->gamma^*", { form_factors } },
+            { "B->omega", { form_factors } },
+            { "B->omegalnu", { b_decays } },
+            { "B->pi", { form_factors } },
+            { "B->pilnu", { b_decays } },
+            { "B->pipi", { form_factors } },
+            { "B->pipilnu", { b_decays } },
+            { "B->rho", { form_factors } },
+            { "B->rholnu", { b_decays } },
+            { "B_q->ll", { rare_b_decays } },
+            { "B_s", { form_factors } },
+            { "B_s->D_s", { form_factors } },
+            { "B_s->D_s^*", { form_factors } },
+            { "B_s->D_s^*lnu", { b_decays } },
+            { "B_s->D_slnu", { b_decays } },
+            { "B_s->K", { form_factors } },
+            { "B_s->K^*", { form_factors } },
+            { "B_s->K^*lnu", { b_decays } },
+            { "B_s->Klnu", { b_decays } },
+            { "B_s->phi", { form_factors, rare_b_decays } },
+            { "B_s->phill", { rare_b_decays } },
+            { "B_s->phipsi", { rare_b_decays } },
+            { "B_s0", { form_factors } },
+            { "B_s1", { form_factors } },
+            { "B_s<->Bbar_s", { meson_mixing } },
+            { "B_s^*", { form_factors } },
+            { "B_u->enumumu", { b_decays } },
+            { "B_u->gammalnu", { b_decays } },
+            { "B_u->lnu", { b_decays } },
+            { "B_u->munuee", { b_decays } },
+            { "B_u->taunuee", { b_decays } },
+            { "B_u->taunumumu", { b_decays } },
+            { "Lambda_b->Lambda", { form_factors } },
+            { "Lambda_b->Lambda(1520)", { form_factors } },
+            { "Lambda_b->Lambda(1520)gamma", { rare_b_decays } },
+            { "Lambda_b->Lambda(1520)ll", { rare_b_decays } },
+            { "Lambda_b->Lambda_c", { form_factors } },
+            { "Lambda_b->Lambda_c(2595)lnu", { b_decays } },
+            { "Lambda_b->Lambda_c(2625)lnu", { b_decays } },
+            { "Lambda_b->Lambda_clnu", { b_decays } },
+            { "Lambda_b->Lambdall", { rare_b_decays } },
+            { "b->c", { form_factors } },
+            { "b->s", { rare_b_decays } },
+        };
+    }
+
+    ObservableEntries::ObservableEntries() :
+        _entries(&impl::observable_entries)
+    {
+    }
+
+    ObservableEntries::~ObservableEntries() = default;
+
+    void
+    ObservableEntries::_make_section(const unsigned & index) const
+    {
+        if (_sections.end() != _sections.find(index))
+            return;
+
+        // the section's entries are registered while it is being created. Mark it as created beforehand,
+        // since its expression observables might look up further entries with the same prefix.
+        auto & section = _sections.insert(std::make_pair(index, ObservableSection(nullptr))).first->second;
+        section = impl::observable_section_makers[index]();
+
+        for (const auto & group : section)
+        {
+            for (const auto & entry : group)
             {
-                _entries->insert(group.begin(), group.end());
+                auto p = impl::observable_sections_by_prefix.find(entry.first.prefix_part().str());
+                if ((impl::observable_sections_by_prefix.end() == p) || (p->second.end() == std::find(p->second.begin(), p->second.end(), index)))
+                {
+                    throw InternalError("ObservableEntries: the table of prefixes does not associate observable '"
+                            + entry.first.str() + "' with section '" + section.name() + "'");
+                }
             }
         }
     }
 
-    ObservableEntries::~ObservableEntries() = default;
+    void
+    ObservableEntries::_make_all_sections() const
+    {
+        if (! _ordered_sections.empty())
+            return;
+
+        for (unsigned i = 0 ; i < impl::observable_section_makers.size() ; ++i)
+        {
+            _make_section(i);
+        }
+
+        for (const auto & i : impl::observable_section_order)
+        {
+            _ordered_sections.push_back(_sections.find(i)->second);
+        }
+
+        Log::instance()->message("ObservableEntries::_make_all_sections()", ll_debug)
+            << "Total number of registered observables: " << _entries->size();
+    }
+
+    const std::map<QualifiedName, std::shared_ptr<const ObservableEntry>> &
+    ObservableEntries::entries() const
+    {
+        Lock l(_mutex);
+
+        _make_all_sections();
+
+        return *_entries;
+    }
+
+    const std::vector<ObservableSection> &
+    ObservableEntries::sections() const
+    {
+        Lock l(_mutex);
+
+        _make_all_sections();
+
+        return _ordered_sections;
+    }
+
+    std::shared_ptr<const ObservableEntry>
+    ObservableEntries::find(const QualifiedName & key) const
+    {
+        Lock l(_mutex);
+
+        auto i = _entries->find(key);
+        if (_entries->end() != i)
+            return i->second;
+
+        auto p = impl::observable_sections_by_prefix.find(key.prefix_part().str());
+        if (impl::observable_sections_by_prefix.end() == p)
+            return nullptr;
+
+        for (const auto & index : p->second)
+        {
+            _make_section(index);
+        }
+
+        i = _entries->find(key);
+        if (_entries->end() != i)
+            return i->second;
+
+        return nullptr;
+    }
 
     void
     ObservableEntries::insert_or_assign(const QualifiedName & key, const std::shared_ptr<const ObservableEntry> & value)
     {
+        Lock l(_mutex);
+
         auto result = _entries->insert_or_assign(key, value);
 
         if (! result.second)
@@ -81,13 +256,10 @@ namespace eos
     ObservablePtr
     Observable::make(const QualifiedName & name, const Parameters & parameters, const Kinematics & kinematics, const Options & _options)
     {
-        const std::map<QualifiedName, std::shared_ptr<const ObservableEntry>> & observable_entries = ObservableEntries::instance()->entries();
-
         // check if 'name' matches a simple observable
+        if (auto entry = ObservableEntries::instance()->find(name))
         {
-            auto i = observable_entries.find(name);
-            if (observable_entries.end() != i)
-                return i->second->make(parameters, kinematics, name.options() + _options);
+            return entry->make(parameters, kinematics, name.options() + _options);
         }
 
         // check if 'name' matches a parameter
@@ -105,38 +277,6 @@ namespace eos
         return ObservablePtr();
     }
 
-    class ObservableSections :
-        public InstantiationPolicy<ObservableSections, Singleton>
-    {
-        private:
-            std::vector<ObservableSection> _sections;
-
-            ObservableSections()
-            {
-                // ensure that the observable entries have been generated already
-                auto entries = std::distance(ObservableEntries::instance()->entries().begin(), ObservableEntries::instance()->entries().end());
-                Log::instance()->message("ObservableSections::ObservableSections()", ll_debug)
-                    << "Total number of registered observables: " << entries;
-
-                _sections = std::vector<ObservableSection>({
-                    make_b_decays_section(),
-                    make_rare_b_decays_section(),
-                    make_meson_mixing_section(),
-                    make_form_factors_section(),
-                });
-            }
-
-            ~ObservableSections() = default;
-
-        public:
-            friend class InstantiationPolicy<ObservableSections, Singleton>;
-
-            const std::vector<ObservableSection> & sections() const
-            {
-                return _sections;
-            }
-    };
-
     /* ObservableEntry */
 
     ObservableEntry::ObservableEntry()
@@ -253,15 +393,6 @@ namespace eos
     template<>
     struct Implementation<Observables>
     {
-        std::vector<ObservableSection> observable_sections;
-
-        std::map<QualifiedName, ObservableEntryPtr> observable_entries;
-
-        Implementation() :
-            observable_sections(ObservableSections::instance()->sections()),
-            observable_entries(ObservableEntries::instance()->entries())
-        {
-        }
     };
 
     Observables::Observables() :
@@ -276,13 +407,7 @@ namespace eos
     ObservableEntryPtr
     Observables::operator[] (const QualifiedName & qn) const
     {
-        const auto & observable_entries = ObservableEntries::instance()->entries();
-
-        auto i = observable_entries.find(qn);
-        if (i != observable_entries.end())
-            return i->second;
-
-        return ObservableEntryPtr(nullptr);
+        return ObservableEntries::instance()->find(qn);
     }
 
     Observables::ObservableIterator
@@ -304,13 +429,13 @@ namespace eos
     Observables::SectionIterator
     Observables::begin_sections() const
     {
-        return SectionIterator(_imp->observable_sections.begin());
+        return SectionIterator(ObservableEntries::instance()->sections().begin());
     }
 
     Observables::SectionIterator
     Observables::end_sections() const
     {
-        return SectionIterator(_imp->observable_sections.end());
+        return SectionIterator(ObservableEntries::instance()->sections().end());
     }
 
     void
@@ -25,6 +25,7 @@
 #include <eos/utils/exception.hh>
 #include <eos/utils/instantiation_policy.hh>
 #include <eos/utils/kinematic.hh>
+#include <eos/utils/mutex.hh>
 #include <eos/utils/options.hh>
 #include <eos/utils/parameters.hh>
 #include <eos/utils/qualified-name.hh>
@@ -32,6 +33,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 namespace eos
 {
@@ -243,20 +245,53 @@ namespace eos
     extern template class WrappedForwardIterator<Observables::ObservableIteratorTag, const std::pair<const QualifiedName, ObservableEntryPtr>>;
     extern template class WrappedForwardIterator<Observables::SectionIteratorTag, const ObservableSection &>;
 
+    /*!
+     * Registry of all known ObservableEntry objects.
+     *
+     * The entries are created per ObservableSection. A section is only created once an entry
+     * with one of the section's prefixes is looked up, or once all entries or all sections are requested.
+     */
     class ObservableEntries :
         public InstantiationPolicy<ObservableEntries, Singleton>
     {
         private:
             std::map<QualifiedName, std::shared_ptr<const ObservableEntry>> * _entries;
 
+            /// Guards the creation of sections and the registry. Recursive, since creating a section can require entries of other sections.
+            mutable Mutex _mutex;
+
+            /// The sections created so far, keyed by their index in the table of sections.
+            mutable std::map<unsigned, ObservableSection> _sections;
+
+            /// All sections in order of presentation, once they all have been created.
+            mutable std::vector<ObservableSection> _ordered_sections;
+
             ObservableEntries();
 
             ~ObservableEntries();
 
+            /// Create the section with the given index, unless it has been created already. Requires _mutex to be locked.
+            void _make_section(const unsigned & index) const;
+
+            /// Create all sections. Requires _mutex to be locked.
+            void _make_all_sections() const;
+
         public:
             friend class InstantiationPolicy<ObservableEntries, Singleton>;
 
-            inline const std::map<QualifiedName, std::shared_ptr<const ObservableEntry>> & entries() const { return *_entries; }
+            /// Retrieve all entries. Creates all sections.
+            const std::map<QualifiedName, std::shared_ptr<const ObservableEntry>> & entries() const;
+
+            /// Retrieve all sections. Creates all sections.
+            const std::vector<ObservableSection> & sections() const;
+
+            /*!
+             * Retrieve an entry by name.
+             *
+             * Creates only those sections that provide entries with the name's prefix.
+             * Returns nullptr if no such entry exists.
+             */
+            std::shared_ptr<const ObservableEntry> find(const QualifiedName & key) const;
 
             void insert_or_assign(const QualifiedName & key, const std::shared_ptr<const ObservableEntry> & value);
     };
@@ -34,6 +34,20 @@ class ObservableTest :
 
         virtual void run() const
         {
+            /* Test lookup of observables, which creates the sections lazily */
+            {
+                auto observables = Observables();
+
+                auto entry = observables["B->Dlnu::BR"];
+                TEST_CHECK(nullptr != entry);
+                TEST_CHECK(nullptr == observables["B->Dlnu::qwerty"]);
+                TEST_CHECK(nullptr == observables["mass::c"]);
+
+                // creating all sections checks that the table of prefixes is complete
+                TEST_CHECK_EQUAL(std::distance(observables.begin_sections(), observables.end_sections()), 4);
+                TEST_CHECK_EQUAL(observables["B->Dlnu::BR"].get(), entry.get());
+            }
+
             /* Test insertion of a new observable */
             {
                 auto observables = Observables();
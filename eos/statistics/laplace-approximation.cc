@@ -0,0 +1,172 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2026 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <eos/statistics/laplace-approximation.hh>
+#include <eos/utils/exception.hh>
+#include <eos/utils/log.hh>
+#include <eos/utils/private_implementation_pattern-impl.hh>
+
+#include <cmath>
+
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_linalg.h>
+#include <gsl/gsl_matrix.h>
+
+#include <config.h>
+
+#ifdef EOS_USE_GSL_LINALG_CHOLESKY_DECOMP
+#  if (EOS_USE_GSL_LINALG_CHOLESKY_DECOMP == 1)
+#    define GSL_LINALG_CHOLESKY_DECOMP gsl_linalg_cholesky_decomp
+#  else
+#    define GSL_LINALG_CHOLESKY_DECOMP gsl_linalg_cholesky_decomp1
+#  endif
+#else
+#  error EOS_USE_GSL_LINALG_CHOLESKY_DECOMP not defined.
+#endif
+
+namespace eos
+{
+    template <>
+    struct Implementation<LaplaceApproximation>
+    {
+        unsigned dim;
+
+        std::vector<double> mode;
+
+        std::vector<double> hessian;
+
+        std::vector<double> covariance;
+
+        double log_posterior;
+
+        double log_evidence;
+
+        Implementation(const LogPosterior & log_posterior, const double & relative_step) :
+            dim(log_posterior.varied_parameters().size()),
+            hessian(log_posterior.hessian(relative_step)),
+            covariance(dim * dim, 0.0),
+            log_posterior(log_posterior.log_posterior())
+        {
+            for (const auto & p : log_posterior.varied_parameters())
+            {
+                mode.push_back(p.evaluate());
+            }
+
+            if (0 == dim)
+            {
+                log_evidence = this->log_posterior;
+                return;
+            }
+
+            // decompose the negative Hessian matrix, A = L L^T
+            gsl_matrix * a = gsl_matrix_alloc(dim, dim);
+            for (unsigned i = 0 ; i < dim ; ++i)
+            {
+                for (unsigned j = 0 ; j < dim ; ++j)
+                {
+                    gsl_matrix_set(a, i, j, -hessian[i * dim + j]);
+                }
+            }
+
+            int status;
+            try
+            {
+                status = GSL_LINALG_CHOLESKY_DECOMP(a);
+            }
+            catch (GSLError &)
+            {
+                status = GSL_EDOM;
+            }
+
+            if (GSL_SUCCESS != status)
+            {
+                gsl_matrix_free(a);
+                throw InternalError("LaplaceApproximation: the negative Hessian matrix is not positive definite; the parameter point is not a maximum of the posterior");
+            }
+
+            // log det(A) = 2 sum_i log(L_ii)
+            double log_det = 0.0;
+            for (unsigned i = 0 ; i < dim ; ++i)
+            {
+                log_det += 2.0 * std::log(gsl_matrix_get(a, i, i));
+            }
+
+            // the covariance is the inverse of A
+            gsl_linalg_cholesky_invert(a);
+            for (unsigned i = 0 ; i < dim ; ++i)
+            {
+                for (unsigned j = 0 ; j < dim ; ++j)
+                {
+                    covariance[i * dim + j] = gsl_matrix_get(a, i, j);
+                }
+            }
+            gsl_matrix_free(a);
+
+            // integrate the Gaussian density exp(log_posterior - (x - mode)^T A (x - mode) / 2)
+            log_evidence = this->log_posterior + 0.5 * dim * std::log(2.0 * M_PI) - 0.5 * log_det;
+        }
+    };
+
+    LaplaceApproximation::LaplaceApproximation(const LogPosterior & log_posterior, const double & relative_step) :
+        PrivateImplementationPattern<LaplaceApproximation>(new Implementation<LaplaceApproximation>(log_posterior, relative_step))
+    {
+        Log::instance()->message("LaplaceApproximation()", ll_informational)
+            << "Laplace approximation of the log(evidence): " << _imp->log_evidence;
+    }
+
+    LaplaceApproximation::~LaplaceApproximation()
+    {
+    }
+
+    unsigned
+    LaplaceApproximation::dimension() const
+    {
+        return _imp->dim;
+    }
+
+    const std::vector<double> &
+    LaplaceApproximation::mode() const
+    {
+        return _imp->mode;
+    }
+
+    const std::vector<double> &
+    LaplaceApproximation::hessian() const
+    {
+        return _imp->hessian;
+    }
+
+    const std::vector<double> &
+    LaplaceApproximation::covariance() const
+    {
+        return _imp->covariance;
+    }
+
+    double
+    LaplaceApproximation::log_posterior() const
+    {
+        return _imp->log_posterior;
+    }
+
+    double
+    LaplaceApproximation::log_evidence() const
+    {
+        return _imp->log_evidence;
+    }
+}
@@ -0,0 +1,83 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2026 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_EOS_STATISTICS_LAPLACE_APPROXIMATION_HH
+#define EOS_GUARD_EOS_STATISTICS_LAPLACE_APPROXIMATION_HH 1
+
+#include <eos/statistics/log-posterior.hh>
+#include <eos/utils/private_implementation_pattern.hh>
+
+#include <vector>
+
+namespace eos
+{
+    /*!
+     * Approximates a LogPosterior by a multivariate Gaussian density around its mode.
+     *
+     * The current parameter point of the LogPosterior is taken as the mode, e.g., the
+     * best-fit point of a preceding optimization. The covariance of the Gaussian density
+     * is the inverse of the negative Hessian matrix of the Log(posterior), see LogPosterior::hessian().
+     * The integral of the approximating density yields the Laplace approximation of the evidence.
+     */
+    class LaplaceApproximation :
+        public PrivateImplementationPattern<LaplaceApproximation>
+    {
+        public:
+            ///@name Basic Functions
+            ///@{
+            /*!
+             * Constructor.
+             *
+             * Evaluates the Hessian matrix at the current parameter point and inverts it.
+             * Throws an InternalError if the negative Hessian matrix is not positive definite,
+             * i.e., if the current parameter point is not a local maximum of the LogPosterior.
+             *
+             * @param log_posterior The LogPosterior that shall be approximated.
+             * @param relative_step The step size of the finite differences, relative to the ranges of the priors.
+             */
+            LaplaceApproximation(const LogPosterior & log_posterior, const double & relative_step = 1.0e-3);
+
+            /// Destructor.
+            ~LaplaceApproximation();
+            ///@}
+
+            ///@name Results
+            ///@{
+            /// Retrieve the number of varied parameters.
+            unsigned dimension() const;
+
+            /// Retrieve the values of the varied parameters at the mode.
+            const std::vector<double> & mode() const;
+
+            /// Retrieve the Hessian matrix of the Log(posterior) at the mode, as a row-major matrix.
+            const std::vector<double> & hessian() const;
+
+            /// Retrieve the covariance matrix of the approximating Gaussian density, as a row-major matrix.
+            const std::vector<double> & covariance() const;
+
+            /// Retrieve the value of the Log(posterior) at the mode.
+            double log_posterior() const;
+
+            /// Retrieve the logarithm of the evidence in the Laplace approximation.
+            double log_evidence() const;
+            ///@}
+    };
+}
+
+#endif
@@ -0,0 +1,122 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2026 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <config.h>
+
+#include <eos/statistics/laplace-approximation.hh>
+#include <eos/statistics/log-posterior_TEST.hh>
+
+#include <cmath>
+
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_vector.h>
+
+using namespace test;
+using namespace eos;
+
+class LaplaceApproximationTest :
+    public TestCase
+{
+    public:
+        LaplaceApproximationTest() :
+            TestCase("laplace_approximation_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            // gaussian posterior with mean 4.3 and variance 0.005, and an uncorrelated
+            // parameter with mean 1.5 and variance 0.01 that none of the observables uses
+            {
+                LogPosterior log_posterior = make_log_posterior(false);
+                log_posterior.add(LogPrior::CurtailedGauss(log_posterior.parameters(), "mass::c",
+                        ParameterRange{ 1.0, 2.0 }, 1.4, 1.5, 1.6));
+
+                log_posterior[0].set(4.3);
+                log_posterior[1].set(1.5);
+
+                LaplaceApproximation laplace(log_posterior);
+
+                TEST_CHECK_EQUAL(laplace.dimension(), 2u);
+                TEST_CHECK_EQUAL(laplace.mode()[0], 4.3);
+                TEST_CHECK_EQUAL(laplace.mode()[1], 1.5);
+
+                TEST_CHECK_RELATIVE_ERROR(laplace.hessian()[0], -200.0, 1e-5);
+                TEST_CHECK_RELATIVE_ERROR(laplace.hessian()[3], -100.0, 1e-5);
+
+                // the parameters share neither a constraint nor a prior
+                TEST_CHECK_EQUAL(laplace.hessian()[1], 0.0);
+                TEST_CHECK_EQUAL(laplace.hessian()[2], 0.0);
+
+                TEST_CHECK_RELATIVE_ERROR(laplace.covariance()[0], 0.005, 1e-5);
+                TEST_CHECK_RELATIVE_ERROR(laplace.covariance()[3], 0.01,  1e-5);
+                TEST_CHECK_EQUAL(laplace.covariance()[1], 0.0);
+
+                // the evidence is the integral of the product of two normalized gaussians with variance 0.01,
+                // centered at 4.2 and at 4.4
+                TEST_CHECK_NEARLY_EQUAL(laplace.log_evidence(), -1.0 - 0.5 * std::log(0.04 * M_PI), 1e-4);
+
+                // the parameter point is unchanged
+                TEST_CHECK_EQUAL(log_posterior[0].evaluate(), 4.3);
+                TEST_CHECK_EQUAL(log_posterior[1].evaluate(), 1.5);
+            }
+
+            // correlated parameters through a common prior
+            {
+                Parameters parameters = Parameters::Defaults();
+                LogLikelihood llh(parameters);
+                LogPosterior log_posterior(llh);
+
+                gsl_vector * mean = gsl_vector_alloc(2);
+                gsl_vector_set(mean, 0, 1.5);
+                gsl_vector_set(mean, 1, 0.1);
+
+                gsl_matrix * covariance = gsl_matrix_alloc(2, 2);
+                gsl_matrix_set(covariance, 0, 0, 0.01);
+                gsl_matrix_set(covariance, 0, 1, 0.005);
+                gsl_matrix_set(covariance, 1, 0, 0.005);
+                gsl_matrix_set(covariance, 1, 1, 0.04);
+
+                log_posterior.add(LogPrior::MultivariateGaussian(parameters, { "mass::c", "mass::tau" }, mean, covariance));
+
+                log_posterior[0].set(1.5);
+                log_posterior[1].set(0.1);
+
+                LaplaceApproximation laplace(log_posterior);
+
+                TEST_CHECK_RELATIVE_ERROR(laplace.covariance()[0], 0.01,  1e-4);
+                TEST_CHECK_RELATIVE_ERROR(laplace.covariance()[1], 0.005, 1e-4);
+                TEST_CHECK_RELATIVE_ERROR(laplace.covariance()[2], 0.005, 1e-4);
+                TEST_CHECK_RELATIVE_ERROR(laplace.covariance()[3], 0.04,  1e-4);
+
+                // the prior is normalized
+                TEST_CHECK_NEARLY_EQUAL(laplace.log_evidence(), 0.0, 1e-4);
+            }
+
+            // a flat posterior has no maximum
+            {
+                Parameters parameters = Parameters::Defaults();
+                LogLikelihood llh(parameters);
+                LogPosterior log_posterior(llh);
+                log_posterior.add(LogPrior::Flat(parameters, "mass::c", ParameterRange{ 1.0, 2.0 }));
+
+                TEST_CHECK_THROWS(InternalError, LaplaceApproximation(log_posterior, 1.0e-3));
+            }
+        }
+} laplace_approximation_test;
@@ -24,13 +24,19 @@
 #include <eos/utils/observable_cache.hh>
 #include <eos/maths/power-of.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/thread_pool.hh>
 #include <eos/utils/verify.hh>
 #include <eos/utils/wrapped_forward_iterator-impl.hh>
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <cstdint>
+#include <iterator>
 #include <limits>
 #include <map>
+#include <memory>
+#include <numeric>
 
 #include <gsl/gsl_blas.h>
 #include <gsl/gsl_cdf.h>
@@ -119,9 +125,8 @@ namespace eos
                 return result;
             }
 
-            virtual double evaluate() const
+            double evaluate(const double & value) const
             {
-                double value = cache[id];
                 double sigma = 0.0;
 
                 // allow for asymmetric Gaussian uncertainty
@@ -135,6 +140,21 @@ namespace eos
                 return norm - power_of<2>(chi) / 2.0;
             }
 
+            virtual double evaluate() const
+            {
+                return evaluate(cache[id]);
+            }
+
+            virtual void evaluate_batch(const double * predictions, const std::size_t & n_points, double * results) const
+            {
+                const std::size_t n_predictions = cache.size();
+
+                for (std::size_t i = 0 ; i < n_points ; ++i)
+                {
+                    results[i] = evaluate(predictions[i * n_predictions + id]);
+                }
+            }
+
             virtual unsigned number_of_observations() const
             {
                 return _number_of_observations;
@@ -307,13 +327,28 @@ namespace eos
                     return 1.0 - gsl_sf_gamma_inc_Q(alpha, z);
             }
 
-            virtual double evaluate() const
+            double evaluate(const double & x) const
             {
-                double value = (cache[id] - nu) / lambda;
+                double value = (x - nu) / lambda;
 
                 return norm + alpha * value - std::exp(value);
             }
 
+            virtual double evaluate() const
+            {
+                return evaluate(cache[id]);
+            }
+
+            virtual void evaluate_batch(const double * predictions, const std::size_t & n_points, double * results) const
+            {
+                const std::size_t n_predictions = cache.size();
+
+                for (std::size_t i = 0 ; i < n_points ; ++i)
+                {
+                    results[i] = evaluate(predictions[i * n_predictions + id]);
+                }
+            }
+
             virtual unsigned number_of_observations() const
             {
                 return _number_of_observations;
@@ -540,14 +575,29 @@ namespace eos
                     return 1.0 - gsl_sf_gamma_inc_Q(alpha, w);
             }
 
-            virtual double evaluate() const
+            double evaluate(const double & x) const
             {
                 // standardized transform
-                const double z = (cache[id] - physical_limit) / theta;
+                const double z = (x - physical_limit) / theta;
 
                 return norm + (alpha * beta - 1) * std::log(z) - std::pow(z, beta);
             }
 
+            virtual double evaluate() const
+            {
+                return evaluate(cache[id]);
+            }
+
+            virtual void evaluate_batch(const double * predictions, const std::size_t & n_points, double * results) const
+            {
+                const std::size_t n_predictions = cache.size();
+
+                for (std::size_t i = 0 ; i < n_points ; ++i)
+                {
+                    results[i] = evaluate(predictions[i * n_predictions + id]);
+                }
+            }
+
             inline double mode() const
             {
                 return physical_limit + theta * std::pow(alpha - 1 / beta, 1 / beta);
@@ -752,6 +802,35 @@ namespace eos
                 return ret_val;
             }
 
+            void evaluate_batch(const double * predictions, const std::size_t & n_points, double * results) const
+            {
+                // one row per component
+                std::vector<double> values(components.size() * n_points);
+                for (std::size_t c = 0 ; c < components.size() ; ++c)
+                {
+                    components[c]->evaluate_batch(predictions, n_points, values.data() + c * n_points);
+                }
+
+                for (std::size_t i = 0 ; i < n_points ; ++i)
+                {
+                    // find biggest element
+                    double max_val = values[i];
+                    for (std::size_t c = 1 ; c < components.size() ; ++c)
+                    {
+                        max_val = std::max(max_val, values[c * n_points + i]);
+                    }
+
+                    // computed weighted sum, renormalize exponents
+                    double ret_val = 0.0;
+                    for (std::size_t c = 0 ; c < components.size() ; ++c)
+                    {
+                        ret_val += weights[c] * std::exp(values[c * n_points + i] - max_val);
+                    }
+
+                    results[i] = std::log(ret_val) + max_val;
+                }
+            }
+
             unsigned number_of_observations() const
             {
                 return components.front()->number_of_observations();
@@ -800,14 +879,8 @@ namespace eos
             // the normalization constant of the density
             const double _norm;
 
-            // cholesky matrix of covariance, and inverse of covariance
+            // lower triangular cholesky matrix of covariance
             gsl_matrix * _chol;
-            gsl_matrix * _covariance_inv;
-
-            // temporary storage for evaluation
-            gsl_vector * _observables;
-            gsl_vector * _measurements;
-            gsl_vector * _measurements_2;
 
             MultivariateGaussianBlock(const ObservableCache & cache, const std::vector<ObservableCache::Id> && ids,
                     gsl_vector * mean, gsl_matrix * covariance, gsl_matrix * response, const unsigned & number_of_observations) :
@@ -820,11 +893,7 @@ namespace eos
                 _response(response),
                 _number_of_observations(number_of_observations),
                 _norm(compute_norm()),
-                _chol(gsl_matrix_alloc(covariance->size1, covariance->size2)),
-                _covariance_inv(gsl_matrix_alloc(covariance->size1, covariance->size2)),
-                _observables(gsl_vector_alloc(_dim_pred)),
-                _measurements(gsl_vector_alloc(_dim_meas)),
-                _measurements_2(gsl_vector_alloc(_dim_meas))
+                _chol(gsl_matrix_alloc(covariance->size1, covariance->size2))
             {
                 if (_covariance->size1 != _covariance->size2)
                     throw InternalError("MultivariateGaussianBlock: covariance matrix is not a square matrix");
@@ -841,7 +910,6 @@ namespace eos
                 // cholesky decomposition (informally: the sqrt of the covariance matrix)
                 // the GSL matrix contains both the cholesky and its transpose, see GSL reference, ch. 14.5
                 cholesky();
-                invert_covariance();
 
                 // keep only the lower and diagonal parts, set upper parts to zero
                 for (unsigned i = 0; i < _dim_meas ; ++i)
@@ -855,14 +923,10 @@ namespace eos
 
             virtual ~MultivariateGaussianBlock()
             {
-                gsl_matrix_free(_covariance_inv);
                 gsl_matrix_free(_chol);
                 gsl_matrix_free(_covariance);
                 gsl_matrix_free(_response);
 
-                gsl_vector_free(_measurements_2);
-                gsl_vector_free(_measurements);
-                gsl_vector_free(_observables);
                 gsl_vector_free(_mean);
             }
 
@@ -887,16 +951,18 @@ namespace eos
                     result += ")";
                 }
                 result += "), inverse covariance matrix = (";
+                gsl_matrix * covariance_inv = inverse_covariance();
                 for (std::size_t i = 0 ; i < k ; ++i)
                 {
                     result += "( ";
                     for (std::size_t j = 0 ; j < k ; ++j)
                     {
-                        result += stringify(gsl_matrix_get(_covariance_inv, i, j)) + " ";
+                        result += stringify(gsl_matrix_get(covariance_inv, i, j)) + " ";
                     }
                     result += ")";
                 }
                 result += " )";
+                gsl_matrix_free(covariance_inv);
 
                 if (0 == _number_of_observations)
                     result += "; no observation";
@@ -916,16 +982,28 @@ namespace eos
             }
 
             // invert covariance matrix based on previously obtained Cholesky decomposition
-            void invert_covariance()
+            // only used for display purposes; the evaluation relies on triangular solves with the Cholesky matrix
+            gsl_matrix * inverse_covariance() const
             {
-                // copy cholesky matrix
-                gsl_matrix_memcpy(_covariance_inv, _chol);
+                // copy cholesky matrix, and restore the transpose in the upper part as expected by GSL
+                gsl_matrix * result = gsl_matrix_alloc(_dim_meas, _dim_meas);
+                gsl_matrix_memcpy(result, _chol);
+                for (unsigned i = 0 ; i < _dim_meas ; ++i)
+                {
+                    for (unsigned j = i + 1 ; j < _dim_meas ; ++j)
+                    {
+                        gsl_matrix_set(result, i, j, gsl_matrix_get(_chol, j, i));
+                    }
+                }
 
                 // compute inverse matrix from cholesky
-                if (GSL_SUCCESS != gsl_linalg_cholesky_invert(_covariance_inv))
+                if (GSL_SUCCESS != gsl_linalg_cholesky_invert(result))
                 {
+                    gsl_matrix_free(result);
                     throw InternalError("MultivariateGaussianBlock: Cholesky inversion failed");
                 }
+
+                return result;
             }
 
 
@@ -978,25 +1056,28 @@ namespace eos
 
             double chi_square() const
             {
-                // read observable values from cache, and subtract mean
+                // use local storage, so that the block can be evaluated concurrently
+                std::vector<double> observables(_dim_pred), residuals(_dim_meas);
+                gsl_vector_view o = gsl_vector_view_array(observables.data(), _dim_pred);
+                gsl_vector_view r = gsl_vector_view_array(residuals.data(), _dim_meas);
+
+                // read observable values from cache
                 for (auto i = 0u ; i < _dim_pred ; ++i)
                 {
-                    gsl_vector_set(_observables, i, _cache[_ids[i]]);
+                    observables[i] = _cache[_ids[i]];
                 }
 
-                // prepare for centering
-                //   measurements <- mean
-                gsl_vector_memcpy(_measurements, _mean);
-
                 // apply response matrix and center the gaussian:
-                //   measurements <- R * observables - measurements
-                gsl_blas_dgemv(CblasNoTrans, 1.0, _response, _observables, -1.0, _measurements);
+                //   residuals <- R * observables - mean
+                gsl_vector_memcpy(&r.vector, _mean);
+                gsl_blas_dgemv(CblasNoTrans, 1.0, _response, &o.vector, -1.0, &r.vector);
 
-                // observables <- inv(covariance) * measurements
-                gsl_blas_dgemv(CblasNoTrans, 1.0, _covariance_inv, _measurements, 0.0, _measurements_2);
+                // chi^2 = r^T inv(covariance) r = |inv(L) r|^2, with covariance = L L^T
+                //   residuals <- inv(L) * residuals
+                gsl_blas_dtrsv(CblasLower, CblasNoTrans, CblasNonUnit, _chol, &r.vector);
 
                 double result;
-                gsl_blas_ddot(_measurements, _measurements_2, &result);
+                gsl_blas_ddot(&r.vector, &r.vector, &result);
 
                 return result;
             }
@@ -1006,6 +1087,50 @@ namespace eos
                 return _norm - 0.5 * chi_square();
             }
 
+            virtual void evaluate_batch(const double * predictions, const std::size_t & n_points, double * results) const
+            {
+                if (0 == n_points)
+                    return;
+
+                const std::size_t n_predictions = _cache.size();
+
+                // read observable values from the predictions, one row per point
+                gsl_matrix * observables = gsl_matrix_alloc(n_points, _dim_pred);
+                for (std::size_t i = 0 ; i < n_points ; ++i)
+                {
+                    for (auto j = 0u ; j < _dim_pred ; ++j)
+                    {
+                        gsl_matrix_set(observables, i, j, predictions[i * n_predictions + _ids[j]]);
+                    }
+                }
+
+                // apply response matrix and center the gaussian, one row per point:
+                //   residuals <- observables * R^T - mean^T
+                gsl_matrix * residuals = gsl_matrix_alloc(n_points, _dim_meas);
+                for (std::size_t i = 0 ; i < n_points ; ++i)
+                {
+                    gsl_matrix_set_row(residuals, i, _mean);
+                }
+                gsl_blas_dgemm(CblasNoTrans, CblasTrans, 1.0, observables, _response, -1.0, residuals);
+
+                // solve for all points at once:
+                //   residuals <- residuals * inv(L^T), i.e., each row r^T becomes (inv(L) r)^T
+                gsl_blas_dtrsm(CblasRight, CblasLower, CblasTrans, CblasNonUnit, 1.0, _chol, residuals);
+
+                for (std::size_t i = 0 ; i < n_points ; ++i)
+                {
+                    gsl_vector_const_view r = gsl_matrix_const_row(residuals, i);
+
+                    double chi_square;
+                    gsl_blas_ddot(&r.vector, &r.vector, &chi_square);
+
+                    results[i] = _norm - 0.5 * chi_square;
+                }
+
+                gsl_matrix_free(residuals);
+                gsl_matrix_free(observables);
+            }
+
             virtual unsigned number_of_observations() const
             {
                 return _number_of_observations;
@@ -1013,26 +1138,18 @@ namespace eos
 
             virtual double sample(gsl_rng * rng) const
             {
-                // generate standard normals in observables
+                // To be consistent with the univariate Gaussian, we would center observables around theory,
+                // then compare to theory. Hence we can forget about theory, and stay centered on zero.
+                // A residual r = L z, with z a vector of standard normals, yields
+                //   chi^2 = r^T inv(covariance) r = |inv(L) L z|^2 = |z|^2.
+                double chi_square = 0.0;
                 for (auto i = 0u ; i < _dim_meas ; ++i)
                 {
-                    gsl_vector_set(_measurements, i, gsl_ran_ugaussian(rng));
+                    const double z = gsl_ran_ugaussian(rng);
+                    chi_square += z * z;
                 }
 
-                // transform: observables2 <- _chol * observables
-                gsl_blas_dgemv(CblasNoTrans, 1.0, _chol, _measurements, 0.0, _measurements_2);
-
-                // To be consistent with the univariate Gaussian, we would center observables around theory,
-                // then compare to theory. Hence we can forget about theory, and stay centered on zero.
-                // transform: observables <- inv(covariance) * observables2
-                gsl_blas_dgemv(CblasNoTrans, 1.0, _covariance_inv, _measurements_2, 0.0, _measurements);
-
-                double result;
-                gsl_blas_ddot(_measurements, _measurements_2, &result);
-                result *= -0.5;
-                result += _norm;
-
-                return result;
+                return _norm - 0.5 * chi_square;
             }
 
             virtual double significance() const
@@ -1088,15 +1205,8 @@ namespace eos
                 return result;
             }
 
-            virtual double evaluate() const
+            double evaluate(const double & saturation) const
             {
-                double saturation = 0.0;
-
-                for (auto i : ids)
-                {
-                    saturation += cache[i];
-                }
-
                 if (saturation < 0.0)
                 {
                     throw InternalError("Contribution to the uniform bound must be positive; found to be negative!");
@@ -1119,6 +1229,35 @@ namespace eos
                 }
             }
 
+            virtual double evaluate() const
+            {
+                double saturation = 0.0;
+
+                for (auto i : ids)
+                {
+                    saturation += cache[i];
+                }
+
+                return evaluate(saturation);
+            }
+
+            virtual void evaluate_batch(const double * predictions, const std::size_t & n_points, double * results) const
+            {
+                const std::size_t n_predictions = cache.size();
+
+                for (std::size_t p = 0 ; p < n_points ; ++p)
+                {
+                    double saturation = 0.0;
+
+                    for (auto i : ids)
+                    {
+                        saturation += predictions[p * n_predictions + i];
+                    }
+
+                    results[p] = evaluate(saturation);
+                }
+            }
+
             virtual unsigned number_of_observations() const
             {
                 return 0.0;
@@ -1314,9 +1453,28 @@ namespace eos
         // Container for all named constraints
         std::vector<Constraint> constraints;
 
+        // Whether the evaluations are profiled
+        bool profiling;
+
+        // Contains the profiling information of each likelihood block, in the order of the constraints
+        struct Timing
+        {
+            unsigned long calls = 0;
+
+            unsigned long exceptions = 0;
+
+            std::chrono::steady_clock::duration time = std::chrono::steady_clock::duration::zero();
+        };
+        mutable std::vector<Timing> timings;
+
+        // Increases with every change of the configuration
+        unsigned long revision;
+
         Implementation(const Parameters & parameters) :
             parameters(parameters),
-            cache(parameters)
+            cache(parameters),
+            profiling(false),
+            revision(0)
         {
         }
 
@@ -1347,36 +1505,53 @@ namespace eos
                                      << "The value of the test statistic (total likelihood) "
                                      << "for the current parameters is = " << t_obs;
 
-            // count data sets with smaller likelihood
-            unsigned n_low = 0;
-
-            // test value
-            double t;
-
-            gsl_rng * rng = gsl_rng_alloc(gsl_rng_mt19937);
-            gsl_rng_set(rng, datasets);
-
             Log::instance()->message("log_likelihood.bootstrap_pvalue", ll_informational)
                                      << "Begin sampling " << datasets << " simulated "
                                      << "values of the likelihood";
 
-            // collect samples
-            for (unsigned i = 0 ; i < datasets ; ++i)
+            // The data sets are split into batches of fixed size, each with its own random number stream.
+            // Since the streams depend only on the batch index, and the counts are integers, the result
+            // does not depend on the number of threads.
+            static const unsigned batch_size = 4096;
+            const unsigned batches = (datasets + batch_size - 1) / batch_size;
+            std::vector<unsigned> n_low_per_batch(batches, 0);
+
+            TaskGroup tasks;
+            for (unsigned batch = 0 ; batch < batches ; ++batch)
             {
-                t = 0.0;
-                for (const auto & constraint : constraints)
-                {
-                    for (auto b = constraint.begin_blocks(), b_end = constraint.end_blocks() ; b != b_end ; ++b)
+                tasks.run([this, batch, datasets, t_obs, &n_low_per_batch] () {
+                    // release the generator even if sampling throws
+                    std::unique_ptr<gsl_rng, decltype(&gsl_rng_free)> rng(gsl_rng_alloc(gsl_rng_mt19937), &gsl_rng_free);
+                    gsl_rng_set(rng.get(), bootstrap_seed(datasets, batch));
+
+                    const unsigned first = batch * batch_size;
+                    const unsigned last  = std::min(first + batch_size, datasets);
+
+                    unsigned n_low = 0;
+                    for (unsigned i = first ; i < last ; ++i)
                     {
-                        t += (*b)->sample(rng);
+                        double t = 0.0;
+                        for (const auto & constraint : constraints)
+                        {
+                            for (auto b = constraint.begin_blocks(), b_end = constraint.end_blocks() ; b != b_end ; ++b)
+                            {
+                                t += (*b)->sample(rng.get());
+                            }
+                        }
+
+                        if (t < t_obs)
+                        {
+                            ++n_low;
+                        }
                     }
-                }
 
-                if (t < t_obs)
-                {
-                    ++n_low;
-                }
+                    n_low_per_batch[batch] = n_low;
+                });
             }
+            tasks.wait();
+
+            // count data sets with smaller likelihood
+            const unsigned n_low = std::accumulate(n_low_per_batch.cbegin(), n_low_per_batch.cend(), 0u);
 
             // mode of binomial posterior
             double p = n_low / double(datasets);
@@ -1390,13 +1565,115 @@ namespace eos
                                      << "The simulated p-value is " << p
                                      << " with uncertainty " << uncertainty;
 
-            gsl_rng_free(rng);
-
             return std::make_pair(p, uncertainty);
         }
 
+        // Derive the seed of a batch's random number stream from the number of data sets and the batch index,
+        // using the SplitMix64 finalizer to decorrelate the seeds of neighbouring batches
+        static unsigned long bootstrap_seed(const unsigned & datasets, const unsigned & batch)
+        {
+            std::uint64_t z = (std::uint64_t(datasets) << 32) + batch + 0x9e3779b97f4a7c15ull;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+
+            return (z ^ (z >> 31)) & 0xffffffffull;
+        }
+
+        // Evaluate all likelihood blocks, and record their profiling information
+        double profiled_log_likelihood() const
+        {
+            double result = 0.0;
+            unsigned k = 0;
+
+            for (const auto & constraint : constraints)
+            {
+                for (auto b = constraint.begin_blocks(), b_end = constraint.end_blocks() ; b != b_end ; ++b, ++k)
+                {
+                    auto & t = timings[k];
+                    const auto start = std::chrono::steady_clock::now();
+
+                    double llh;
+                    try
+                    {
+                        llh = (*b)->evaluate();
+                    }
+                    catch (...)
+                    {
+                        t.time += std::chrono::steady_clock::now() - start;
+                        t.calls += 1;
+                        t.exceptions += 1;
+                        throw;
+                    }
+
+                    t.time += std::chrono::steady_clock::now() - start;
+                    t.calls += 1;
+
+                    if (! std::isfinite(llh))
+                        return -std::numeric_limits<double>::infinity();
+
+                    result += llh;
+                }
+            }
+
+            return result;
+        }
+
+        // Evaluate all likelihood blocks at a batch of points, and record their profiling information if enabled
+        void log_likelihood_batch(const double * predictions, const std::size_t & n_points, double * results) const
+        {
+            std::fill(results, results + n_points, 0.0);
+
+            std::vector<double> llh(n_points);
+            unsigned k = 0;
+
+            for (const auto & constraint : constraints)
+            {
+                for (auto b = constraint.begin_blocks(), b_end = constraint.end_blocks() ; b != b_end ; ++b, ++k)
+                {
+                    if (profiling)
+                    {
+                        auto & t = timings[k];
+                        const auto start = std::chrono::steady_clock::now();
+
+                        try
+                        {
+                            (*b)->evaluate_batch(predictions, n_points, llh.data());
+                        }
+                        catch (...)
+                        {
+                            t.time += std::chrono::steady_clock::now() - start;
+                            t.calls += n_points;
+                            t.exceptions += n_points;
+                            throw;
+                        }
+
+                        t.time += std::chrono::steady_clock::now() - start;
+                        t.calls += n_points;
+                    }
+                    else
+                    {
+                        (*b)->evaluate_batch(predictions, n_points, llh.data());
+                    }
+
+                    for (std::size_t i = 0 ; i < n_points ; ++i)
+                    {
+                        results[i] += llh[i];
+                    }
+                }
+            }
+
+            for (std::size_t i = 0 ; i < n_points ; ++i)
+            {
+                if (! std::isfinite(results[i]))
+                    results[i] = -std::numeric_limits<double>::infinity();
+            }
+        }
+
         double log_likelihood() const
         {
+            if (profiling)
+                return profiled_log_likelihood();
+
             double result = 0.0;
 
             // loop over all likelihood blocks
@@ -1430,8 +1707,10 @@ namespace eos
             const unsigned & number_of_observations)
     {
         LogLikelihoodBlockPtr b = LogLikelihoodBlock::Gaussian(_imp->cache, observable, min, central, max, number_of_observations);
+        _imp->timings.resize(_imp->timings.size() + 1);
         _imp->constraints.push_back(
             Constraint(observable->name(), std::vector<ObservablePtr>{ observable }, std::vector<LogLikelihoodBlockPtr>{ b }));
+        ++_imp->revision;
     }
 
     void
@@ -1448,8 +1727,11 @@ namespace eos
 
         std::copy(constraint.begin_observables(), constraint.end_observables(), std::back_inserter(observables));
 
+        _imp->timings.resize(_imp->timings.size() + blocks.size());
+
         // retain a proper copy of the constraint to iterate over
         _imp->constraints.push_back(Constraint(constraint.name(), observables, blocks));
+        ++_imp->revision;
     }
 
     LogLikelihood::ConstraintIterator
@@ -1511,6 +1793,12 @@ namespace eos
         return _imp->cache;
     }
 
+    unsigned long
+    LogLikelihood::revision() const
+    {
+        return _imp->revision;
+    }
+
     double
     LogLikelihood::operator() () const
     {
@@ -1518,4 +1806,61 @@ namespace eos
 
         return _imp->log_likelihood();
     }
+
+    void
+    LogLikelihood::evaluate_batch(const std::vector<Parameter::Id> & ids, const double * points, const std::size_t & n_points, const std::size_t & stride,
+            double * results) const
+    {
+        if (0 == n_points)
+            return;
+
+        std::vector<double> predictions(n_points * _imp->cache.size());
+        _imp->cache.update_batch(ids, points, n_points, stride, predictions.data());
+
+        _imp->log_likelihood_batch(predictions.data(), n_points, results);
+    }
+
+    void
+    LogLikelihood::enable_profiling(const bool & enable)
+    {
+        _imp->profiling = enable;
+        _imp->cache.enable_profiling(enable);
+        ++_imp->revision;
+    }
+
+    unsigned
+    LogLikelihood::enable_polynomial_surrogates(const std::list<std::string> & coefficients)
+    {
+        ++_imp->revision;
+
+        return _imp->cache.enable_polynomial_surrogates(coefficients);
+    }
+
+    std::vector<EvaluationProfile>
+    LogLikelihood::profile() const
+    {
+        std::vector<EvaluationProfile> result;
+        result.reserve(_imp->timings.size());
+
+        unsigned k = 0;
+        for (const auto & constraint : _imp->constraints)
+        {
+            const unsigned n_blocks = std::distance(constraint.begin_blocks(), constraint.end_blocks());
+            for (unsigned i = 0 ; i < n_blocks ; ++i, ++k)
+            {
+                const auto & t = _imp->timings[k];
+                const std::string name = (1 == n_blocks) ? constraint.name().str() : constraint.name().str() + "#" + stringify(i);
+                result.push_back(EvaluationProfile{ name, t.calls, t.exceptions, std::chrono::duration<double>(t.time).count() });
+            }
+        }
+
+        return result;
+    }
+
+    void
+    LogLikelihood::reset_profile()
+    {
+        std::fill(_imp->timings.begin(), _imp->timings.end(), Implementation<LogLikelihood>::Timing());
+        _imp->cache.reset_profile();
+    }
 }
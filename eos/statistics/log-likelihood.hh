@@ -35,6 +35,8 @@
 #include <gsl/gsl_vector.h>
 
 #include <cmath>
+#include <cstddef>
+#include <vector>
 
 namespace eos
 {
@@ -61,6 +63,19 @@ namespace eos
             /// Compute the logarithm of the likelihood for this block.
             virtual double evaluate() const = 0;
 
+            /*!
+             * Compute the logarithm of the likelihood for this block at a batch of parameter points.
+             *
+             * The block does not use any shared temporary storage, and can therefore be evaluated
+             * concurrently.
+             *
+             * @param predictions Row-major matrix of the predictions of all observables in this block's cache,
+             *                    with one row per point and one column per cache entry, cf. ObservableCache::update_batch.
+             * @param n_points    The number of points, i.e., the number of rows.
+             * @param results     Array of n_points entries, into which the logarithm of the likelihood is written.
+             */
+            virtual void evaluate_batch(const double * predictions, const std::size_t & n_points, double * results) const = 0;
+
             /// The number of experimental observations (not observables!) used in this block.
             virtual unsigned number_of_observations() const = 0;
 
@@ -364,6 +379,8 @@ namespace eos
              * Calculate a p-value based on the \chi^2
              * test statistic for the current setting of the parameters.
              * @note   The p-value is _not_ corrected for degrees of freedom.
+             * @note   The data sets are simulated in parallel. The result is reproducible
+             *         and independent of the number of threads.
              * @param  datasets The number of simulated data sets
              * @return <p-value, uncertainty>, where the uncertainty is
              * estimated from the standard posterior for a Bernoulli experiment.
@@ -393,11 +410,79 @@ namespace eos
              */
             ObservableCache observable_cache() const;
 
+            /*!
+             * Retrieve the revision of this LogLikelihood's configuration.
+             *
+             * The revision increases whenever a constraint is added, the profiling is enabled or disabled,
+             * or polynomial surrogates are enabled. Clones of this LogLikelihood that have been created at
+             * an earlier revision might no longer reflect its configuration.
+             */
+            unsigned long revision() const;
+
             /*!
              * Evaluate the log likelihood, i.e., return @f[ \log \mathcal{L} = \log P(D | \vec{\theta}, M)=  - \frac{\chi^2}{2} + C@f].
-             * @note: all observables are recalculated
+             * @note: The observable cache is updated first, cf. ObservableCache::update. Only those observables
+             *        are recalculated whose parameters or kinematics have changed since the last evaluation.
              */
             double operator()() const;
+
+            /*!
+             * Evaluate the log likelihood at a batch of parameter points.
+             *
+             * The predictions are computed for all points at once, cf. ObservableCache::update_batch,
+             * and each LogLikelihoodBlock is then evaluated for all points at once.
+             * Points at which any block yields a non-finite value yield -infinity.
+             * The parameters of this LogLikelihood and its cached predictions are not changed.
+             *
+             * @param ids      The ids of the varied parameters, corresponding to the columns of the points.
+             * @param points   Row-major matrix of the values of the varied parameters, with one row per point.
+             * @param n_points The number of points, i.e., the number of rows.
+             * @param stride   The distance between two subsequent rows of points; must be at least ids.size().
+             * @param results  Array of n_points entries, into which the log likelihood is written.
+             */
+            void evaluate_batch(const std::vector<Parameter::Id> & ids, const double * points, const std::size_t & n_points, const std::size_t & stride,
+                    double * results) const;
+            ///@}
+
+            ///@name Profiling
+            ///@{
+            /*!
+             * Enable or disable the profiling of the likelihood's evaluations.
+             *
+             * While enabled, each evaluation records the number of calls, the number of calls
+             * that raised an exception, and the wall time spent for every LogLikelihoodBlock.
+             * The profiling of the underlying ObservableCache is enabled or disabled alongside.
+             *
+             * @param enable Whether the evaluations shall be profiled.
+             */
+            void enable_profiling(const bool & enable = true);
+
+            /*!
+             * Retrieve the profiling information, with one entry per LogLikelihoodBlock in the order of the constraints.
+             *
+             * Blocks are named after their constraint. If a constraint comprises more than one block,
+             * the block's index is appended to the name.
+             */
+            std::vector<EvaluationProfile> profile() const;
+
+            /// Discard all profiling information recorded so far, including that of the underlying ObservableCache.
+            void reset_profile();
+            ///@}
+
+            ///@name Polynomial Surrogates
+            ///@{
+            /*!
+             * Replace the predictions of the underlying ObservableCache by polynomials in the given
+             * coefficients, wherever their dependence on the coefficients is at most quadratic.
+             *
+             * This is beneficial if the coefficients, e.g. the Wilson coefficients of the WET, are varied
+             * much more frequently than any other parameters, since the polynomials are only reconstructed
+             * when the other parameters change. It should be called before the LogLikelihood is cloned.
+             *
+             * @param coefficients The names of the coefficients.
+             * @return The number of predictions that have been replaced.
+             */
+            unsigned enable_polynomial_surrogates(const std::list<std::string> & coefficients);
             ///@}
     };
 
@@ -90,6 +90,36 @@ namespace eos
                     TEST_CHECK_NEARLY_EQUAL(llh(), -10.11630282317536, eps);
                 }
 
+                // batched evaluation
+                // identical to the serial evaluation at each point
+                {
+                    LogLikelihood llh(p);
+                    llh.add(ObservablePtr(new ObservableStub(p, "mass::b(MSbar)", k)), +4.24, +4.25, +4.30);
+                    llh.add(ObservablePtr(new ObservableStub(p, "mass::c",        k)), +1.33, +1.82, +1.90);
+
+                    auto obs = ObservablePtr(new ObservableStub(p, "mass::e", k));
+                    llh.add(Constraint("test::electron-mass", std::vector<ObservablePtr>{ obs },
+                        std::vector<LogLikelihoodBlockPtr>{ LogLikelihoodBlock::LogGamma(llh.observable_cache(), obs, 0.1, 0.11, 0.13, 0.338082, -0.00649023) } ));
+
+                    const std::vector<Parameter::Id> ids{ p["mass::b(MSbar)"].id(), p["mass::c"].id(), p["mass::e"].id() };
+                    const std::vector<double> points{
+                        4.20, 1.5, 0.115,
+                        4.30, 1.8, 0.110,
+                        4.25, 1.2, 0.120
+                    };
+                    std::vector<double> results(3);
+                    llh.evaluate_batch(ids, points.data(), 3, 3, results.data());
+
+                    for (unsigned i = 0 ; i < 3 ; ++i)
+                    {
+                        p["mass::b(MSbar)"] = points[3 * i + 0];
+                        p["mass::c"]        = points[3 * i + 1];
+                        p["mass::e"]        = points[3 * i + 2];
+
+                        TEST_CHECK_NEARLY_EQUAL(results[i], llh(), eps);
+                    }
+                }
+
                 // clone test
                 {
                     LogLikelihood llh1(p);
@@ -283,6 +313,29 @@ namespace eos
                     TEST_CHECK_RELATIVE_ERROR(+0.25, block->significance(), eps);
                 }
 
+                // changes through a view of the parameters reach the cache
+                {
+                    ObservablePtr obs(new ObservableStub(p, "mass::b(MSbar)", k));
+                    ObservableCache cache(p);
+                    const auto id = cache.add(obs);
+                    const auto m_b = p["mass::b(MSbar)"].id();
+
+                    p["mass::b(MSbar)"] = 4.35;
+                    cache.update();
+                    TEST_CHECK_EQUAL(cache[id], 4.35);
+
+                    {
+                        auto view = p.view();
+                        view->values()[m_b] = 4.25;
+                        cache.update();
+                        TEST_CHECK_EQUAL(cache[id], 4.25);
+
+                        view->values()[m_b] = 4.15;
+                    }
+                    cache.update();
+                    TEST_CHECK_EQUAL(cache[id], 4.15);
+                }
+
                 // LogGamma
                 {
                     static const double low_eps = 5e-4;
@@ -543,6 +596,28 @@ namespace eos
                     cache.update();
                     TEST_CHECK_NEARLY_EQUAL(block->evaluate(),-4.597666149, 1e-8);
 
+                    /* batched evaluation */
+                    {
+                        const std::vector<Parameter::Id> ids{ p["mass::b(MSbar)"].id(), p["mass::c"].id() };
+                        const std::vector<double> points{ 4.6, 1.3, 4.35, 1.2 };
+                        std::vector<double> predictions(2 * cache.size());
+                        std::vector<double> results(2);
+
+                        cache.update_batch(ids, points.data(), 2, 2, predictions.data());
+                        block->evaluate_batch(predictions.data(), 2, results.data());
+
+                        TEST_CHECK_NEARLY_EQUAL(results[0], -4.597666149, 1e-8);
+                        TEST_CHECK_NEARLY_EQUAL(results[1],  1.30077135,  1e-8);
+
+                        // univariate blocks, with chi = 3 and 1/2 for block1, and chi = 4 and 2 for block2
+                        std::vector<double> results1(2), results2(2);
+                        block1->evaluate_batch(predictions.data(), 2, results1.data());
+                        block2->evaluate_batch(predictions.data(), 2, results2.data());
+
+                        TEST_CHECK_NEARLY_EQUAL(results1[1] - results1[0], 4.375, 1e-10);
+                        TEST_CHECK_NEARLY_EQUAL(results2[1] - results2[0], 6.0,   1e-10);
+                    }
+
                     /* test sampling */
                     gsl_rng* rng = gsl_rng_alloc(gsl_rng_mt19937);
                     gsl_rng_set(rng, 1243);
@@ -622,6 +697,9 @@ namespace eos
                     // since data restricted to three sigma around central value,
                     // p-value should be slightly biased upwards
                     TEST_CHECK_NEARLY_EQUAL(p_value, 0.852143788, 5e-3);
+
+                    // the simulation is reproducible
+                    TEST_CHECK_EQUAL(p_value, llh.bootstrap_p_value(5e4).first);
                 }
 
                 // mixture density
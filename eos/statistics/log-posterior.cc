@@ -22,9 +22,18 @@
 
 #include <eos/statistics/log-posterior.hh>
 #include <eos/utils/density-impl.hh>
+#include <eos/utils/lock.hh>
 #include <eos/utils/log.hh>
 #include <eos/maths/power-of.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/thread_pool.hh>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <map>
 
 #include <gsl/gsl_cdf.h>
 
@@ -77,6 +86,10 @@ namespace eos
 
         // if not, add to prior container and register parameter objects
         _priors.push_back(prior_clone);
+        {
+            Lock l(_clones.mutex);
+            _clones.idle.clear();
+        }
         for (auto p = prior_clone->begin(), p_end = prior_clone->end() ; p != p_end ; ++p)
         {
             _varied_parameters.push_back(*p);
@@ -107,6 +120,422 @@ namespace eos
         return log_posterior();
     }
 
+    std::vector<double>
+    LogPosterior::gradient(const double & relative_step) const
+    {
+        if (relative_step <= 0.0)
+            throw InternalError("LogPosterior::gradient(): relative step size must be positive");
+
+        const unsigned dim = _varied_parameters.size();
+        std::vector<double> result(dim, 0.0);
+
+        if (0 == dim)
+            return result;
+
+        // the priors' ranges, in the same order as the varied parameters
+        std::vector<ParameterRange> ranges;
+        ranges.reserve(dim);
+        for (const auto & prior : _priors)
+        {
+            const auto prior_ranges = prior->ranges();
+            ranges.insert(ranges.end(), prior_ranges.begin(), prior_ranges.end());
+        }
+
+        // determine the parameters that affect the likelihood
+        std::set<Parameter::Id> used_ids;
+        const ObservableCache cache = _log_likelihood.observable_cache();
+        for (auto o = cache.begin(), o_end = cache.end() ; o != o_end ; ++o)
+        {
+            for (auto i = (*o)->begin(), i_end = (*o)->end() ; i != i_end ; ++i)
+            {
+                used_ids.insert(*i);
+            }
+        }
+
+        const unsigned n_jobs = std::min(ThreadPool::instance()->number_of_threads(), dim);
+        unsigned long revision;
+        auto clones = _check_out_clones(n_jobs, revision);
+
+        TaskGroup tasks;
+        for (unsigned j = 0 ; j < n_jobs ; ++j)
+        {
+            const unsigned first = (j * dim) / n_jobs;
+            const unsigned last  = ((j + 1) * dim) / n_jobs;
+            LogPosterior * posterior = clones[j].get();
+
+            tasks.run([this, posterior, first, last, relative_step, &ranges, &used_ids, &result] () {
+                _synchronize(*posterior);
+
+                for (unsigned i = first ; i < last ; ++i)
+                {
+                    Parameter p = posterior->_varied_parameters[i];
+                    const double x = p.evaluate();
+                    const ParameterRange & range = ranges[i];
+
+                    double h = relative_step * (range.max - range.min);
+                    if ((! std::isfinite(h)) || (h <= 0.0))
+                        h = relative_step * std::max(std::abs(x), 1.0);
+
+                    // keep the stencil within the range, unless the point itself lies outside
+                    const double lo = std::max(x - h, std::min(range.min, x));
+                    const double hi = std::min(x + h, std::max(range.max, x));
+
+                    const bool uses_likelihood = (used_ids.count(p.id()) > 0);
+
+                    p.set(hi);
+                    const double f_hi = uses_likelihood ? posterior->log_posterior() : posterior->log_prior();
+                    p.set(lo);
+                    const double f_lo = uses_likelihood ? posterior->log_posterior() : posterior->log_prior();
+                    p.set(x);
+
+                    result[i] = (f_hi - f_lo) / (hi - lo);
+                }
+            });
+        }
+        tasks.wait();
+        _return_clones(clones, revision);
+
+        return result;
+    }
+
+    std::vector<double>
+    LogPosterior::hessian(const double & relative_step) const
+    {
+        if (relative_step <= 0.0)
+            throw InternalError("LogPosterior::hessian(): relative step size must be positive");
+
+        const unsigned dim = _varied_parameters.size();
+        std::vector<double> result(dim * dim, 0.0);
+
+        if (0 == dim)
+            return result;
+
+        // determine the coupling of each pair of varied parameters:
+        // 0 for none, 1 through a common prior, and 2 through a common constraint
+        std::vector<unsigned char> coupling(dim * dim, 0);
+        std::vector<ParameterRange> ranges;
+        ranges.reserve(dim);
+        for (const auto & prior : _priors)
+        {
+            const unsigned first = ranges.size();
+            const auto prior_ranges = prior->ranges();
+            ranges.insert(ranges.end(), prior_ranges.begin(), prior_ranges.end());
+
+            for (unsigned i = first ; i < ranges.size() ; ++i)
+            {
+                for (unsigned j = first ; j < ranges.size() ; ++j)
+                {
+                    coupling[i * dim + j] = 1;
+                }
+            }
+        }
+
+        std::map<Parameter::Id, unsigned> indices;
+        for (unsigned i = 0 ; i < dim ; ++i)
+        {
+            indices[_varied_parameters[i].id()] = i;
+        }
+
+        std::vector<bool> uses_likelihood(dim, false);
+        for (auto c = _log_likelihood.begin(), c_end = _log_likelihood.end() ; c != c_end ; ++c)
+        {
+            std::set<unsigned> used;
+            for (auto o = c->begin_observables(), o_end = c->end_observables() ; o != o_end ; ++o)
+            {
+                for (auto i = (*o)->begin(), i_end = (*o)->end() ; i != i_end ; ++i)
+                {
+                    auto index = indices.find(*i);
+                    if (indices.end() != index)
+                        used.insert(index->second);
+                }
+            }
+
+            for (const auto & i : used)
+            {
+                uses_likelihood[i] = true;
+                for (const auto & j : used)
+                {
+                    coupling[i * dim + j] = 2;
+                }
+            }
+        }
+
+        // determine the step sizes, and the stencils' centers within the ranges
+        std::vector<double> steps(dim), centers(dim);
+        for (unsigned i = 0 ; i < dim ; ++i)
+        {
+            const double x = _varied_parameters[i].evaluate();
+            const ParameterRange & range = ranges[i];
+
+            double h = relative_step * (range.max - range.min);
+            if ((! std::isfinite(h)) || (h <= 0.0))
+                h = relative_step * std::max(std::abs(x), 1.0);
+            else
+                h = std::min(h, (range.max - range.min) / 2.0);
+
+            // shift the stencil into the range, unless the point itself lies outside
+            double center = x;
+            if ((x >= range.min) && (x <= range.max))
+                center = std::min(std::max(x, range.min + h), range.max - h);
+
+            steps[i]   = h;
+            centers[i] = center;
+        }
+
+        // the entries on and above the diagonal that do not vanish
+        std::vector<std::pair<unsigned, unsigned>> entries;
+        for (unsigned i = 0 ; i < dim ; ++i)
+        {
+            for (unsigned j = i ; j < dim ; ++j)
+            {
+                if ((i == j) || (coupling[i * dim + j] > 0))
+                    entries.push_back(std::make_pair(i, j));
+            }
+        }
+
+        const unsigned n_jobs = std::min<unsigned>(ThreadPool::instance()->number_of_threads(), entries.size());
+        unsigned long revision;
+        auto clones = _check_out_clones(n_jobs, revision);
+
+        // the jobs pick up entries until all entries are evaluated
+        std::atomic<unsigned> next_entry(0);
+
+        TaskGroup tasks;
+        for (unsigned j = 0 ; j < n_jobs ; ++j)
+        {
+            LogPosterior * posterior = clones[j].get();
+
+            tasks.run([this, posterior, dim, &coupling, &uses_likelihood, &steps, &centers, &entries, &next_entry, &result] () {
+                _synchronize(*posterior);
+
+                for (unsigned e = next_entry++ ; e < entries.size() ; e = next_entry++)
+                {
+                    const unsigned i = entries[e].first, k = entries[e].second;
+                    const bool full = (i == k) ? uses_likelihood[i] : (2 == coupling[i * dim + k]);
+                    auto f = [posterior, full] () { return full ? posterior->log_posterior() : posterior->log_prior(); };
+
+                    Parameter p = posterior->_varied_parameters[i];
+                    const double x_p = p.evaluate(), c_p = centers[i], h_p = steps[i];
+
+                    double value;
+                    if (i == k)
+                    {
+                        p.set(c_p + h_p);
+                        const double f_hi = f();
+                        p.set(c_p);
+                        const double f_c  = f();
+                        p.set(c_p - h_p);
+                        const double f_lo = f();
+
+                        value = (f_hi - 2.0 * f_c + f_lo) / (h_p * h_p);
+                    }
+                    else
+                    {
+                        Parameter q = posterior->_varied_parameters[k];
+                        const double x_q = q.evaluate(), c_q = centers[k], h_q = steps[k];
+
+                        p.set(c_p + h_p); q.set(c_q + h_q);
+                        const double f_hh = f();
+                        q.set(c_q - h_q);
+                        const double f_hl = f();
+                        p.set(c_p - h_p);
+                        const double f_ll = f();
+                        q.set(c_q + h_q);
+                        const double f_lh = f();
+                        q.set(x_q);
+
+                        value = (f_hh - f_hl - f_lh + f_ll) / (4.0 * h_p * h_q);
+                    }
+                    p.set(x_p);
+
+                    result[i * dim + k] = value;
+                    result[k * dim + i] = value;
+                }
+            });
+        }
+        tasks.wait();
+        _return_clones(clones, revision);
+
+        return result;
+    }
+
+    void
+    LogPosterior::evaluate_batch(const double * u, const std::size_t & n_points, double * results) const
+    {
+        static const unsigned chunk_size = 16;
+
+        const unsigned dim = _varied_parameters.size();
+        const unsigned n_chunks = (n_points + chunk_size - 1) / chunk_size;
+        const unsigned n_jobs = std::min(ThreadPool::instance()->number_of_threads(), n_chunks);
+
+        if (0 == n_jobs)
+            return;
+
+        unsigned long revision;
+        auto clones = _check_out_clones(n_jobs, revision);
+
+        // the jobs pick up chunks of points until all points are evaluated
+        std::atomic<unsigned> next_chunk(0);
+
+        TaskGroup tasks;
+        for (unsigned j = 0 ; j < n_jobs ; ++j)
+        {
+            LogPosterior * posterior = clones[j].get();
+
+            tasks.run([this, posterior, dim, u, n_points, results, n_chunks, &next_chunk] () {
+                _synchronize(*posterior);
+
+                for (unsigned c = next_chunk++ ; c < n_chunks ; c = next_chunk++)
+                {
+                    const std::size_t last = std::min<std::size_t>((c + 1) * chunk_size, n_points);
+                    for (std::size_t i = c * chunk_size ; i < last ; ++i)
+                    {
+                        results[i] = posterior->_evaluate_u(u + i * dim);
+                    }
+                }
+            });
+        }
+        tasks.wait();
+        _return_clones(clones, revision);
+    }
+
+    void
+    LogPosterior::set_from_u(const double * u, double * par)
+    {
+        for (unsigned k = 0 ; k < _varied_parameters.size() ; ++k)
+        {
+            _varied_parameters[k].set_generator(u[k]);
+        }
+
+        for (const auto & prior : _priors)
+        {
+            prior->sample();
+        }
+
+        for (unsigned k = 0 ; k < _varied_parameters.size() ; ++k)
+        {
+            par[k] = _varied_parameters[k].evaluate();
+        }
+    }
+
+    void
+    LogPosterior::set_from_par(const double * par, double * u)
+    {
+        for (unsigned k = 0 ; k < _varied_parameters.size() ; ++k)
+        {
+            _varied_parameters[k].set(par[k]);
+        }
+
+        for (const auto & prior : _priors)
+        {
+            prior->compute_cdf();
+        }
+
+        for (unsigned k = 0 ; k < _varied_parameters.size() ; ++k)
+        {
+            u[k] = _varied_parameters[k].evaluate_generator();
+        }
+    }
+
+    double
+    LogPosterior::_evaluate_u(const double * u)
+    {
+        for (unsigned k = 0 ; k < _varied_parameters.size() ; ++k)
+        {
+            if ((u[k] < 0.0) || (u[k] > 1.0))
+                return -std::numeric_limits<double>::infinity();
+
+            _varied_parameters[k].set_generator(u[k]);
+        }
+
+        for (const auto & prior : _priors)
+        {
+            prior->sample();
+        }
+
+        try
+        {
+            return log_posterior();
+        }
+        catch (Exception &)
+        {
+            return -std::numeric_limits<double>::infinity();
+        }
+    }
+
+    LogPosterior::Clones &
+    LogPosterior::Clones::operator= (const Clones &)
+    {
+        Lock l(mutex);
+        idle.clear();
+
+        return *this;
+    }
+
+    unsigned long
+    LogPosterior::_revision() const
+    {
+        // both the likelihood's revision and the number of priors increase monotonically, and so does their sum
+        return _log_likelihood.revision() + _priors.size();
+    }
+
+    std::vector<LogPosteriorPtr>
+    LogPosterior::_check_out_clones(const unsigned & n, unsigned long & revision) const
+    {
+        std::vector<LogPosteriorPtr> result;
+        result.reserve(n);
+
+        {
+            Lock l(_clones.mutex);
+
+            // discard clones that no longer reflect the likelihood's configuration or the priors
+            revision = _revision();
+            if (_clones.revision != revision)
+            {
+                _clones.idle.clear();
+                _clones.revision = revision;
+            }
+
+            while ((result.size() < n) && (! _clones.idle.empty()))
+            {
+                result.push_back(std::move(_clones.idle.back()));
+                _clones.idle.pop_back();
+            }
+        }
+
+        // create the missing clones outside of the lock
+        while (result.size() < n)
+        {
+            result.push_back(clone());
+        }
+
+        return result;
+    }
+
+    void
+    LogPosterior::_return_clones(std::vector<LogPosteriorPtr> & clones, const unsigned long & revision) const
+    {
+        Lock l(_clones.mutex);
+
+        if ((revision != _revision()) || (revision != _clones.revision))
+            return;
+
+        std::move(clones.begin(), clones.end(), std::back_inserter(_clones.idle));
+        clones.clear();
+    }
+
+    void
+    LogPosterior::_synchronize(LogPosterior & other) const
+    {
+        Parameters parameters = other.parameters();
+        for (const auto & p : _parameters)
+        {
+            Parameter q = parameters[p.id()];
+            if (q.evaluate() != p.evaluate())
+                q.set(p.evaluate());
+        }
+    }
+
     Parameters
     LogPosterior::parameters() const
     {
@@ -27,10 +27,12 @@
 #include <eos/statistics/log-posterior-fwd.hh>
 #include <eos/statistics/log-prior.hh>
 #include <eos/utils/density.hh>
+#include <eos/utils/mutex.hh>
 #include <eos/utils/private_implementation_pattern.hh>
 #include <eos/utils/verify.hh>
 #include <eos/utils/wrapped_forward_iterator.hh>
 
+#include <cstddef>
 #include <set>
 #include <vector>
 
@@ -63,6 +65,74 @@ namespace eos
 
             /// Evaluate the Log(posterior) density at the current parameter values.
             virtual double evaluate() const;
+
+            /*!
+             * Evaluate the gradient of the Log(posterior) density with respect to the varied
+             * parameters at the current parameter values.
+             *
+             * The derivatives are estimated with a central-difference stencil. Its step sizes are
+             * a fraction of the ranges of the respective priors. The stencil is evaluated in parallel
+             * on clones of this LogPosterior. For parameters that none of the observables uses,
+             * only the Log(prior) is evaluated.
+             *
+             * @param relative_step The step size relative to the range of the parameter's prior.
+             */
+            std::vector<double> gradient(const double & relative_step = 1.0e-4) const;
+
+            /*!
+             * Evaluate the Hessian matrix of the Log(posterior) density with respect to the varied
+             * parameters at the current parameter values.
+             *
+             * The second derivatives are estimated with central-difference stencils, whose step sizes
+             * are a fraction of the ranges of the respective priors. Stencils that would leave a range
+             * are shifted into it. Only those entries are evaluated whose parameters are used by a
+             * common constraint or belong to a common prior; all other entries vanish. For parameters
+             * that none of the constraints uses, only the Log(prior) is evaluated. The entries are
+             * evaluated in parallel on clones of this LogPosterior.
+             *
+             * @param relative_step The step size relative to the range of the parameter's prior.
+             * @return Row-major matrix of varied_parameters().size() x varied_parameters().size() entries.
+             */
+            std::vector<double> hessian(const double & relative_step = 1.0e-3) const;
+
+            /*!
+             * Evaluate the Log(posterior) density for a batch of points in u space.
+             *
+             * Each point is transformed to parameter space through the priors' inverse CDFs.
+             * The points are evaluated in parallel on clones of this LogPosterior.
+             * Points outside the unit hypercube and points for which the evaluation fails
+             * yield -infinity.
+             *
+             * @param u        Row-major matrix of n_points x varied_parameters().size() entries.
+             * @param n_points The number of points.
+             * @param results  Array of n_points entries, into which the values are written.
+             */
+            void evaluate_batch(const double * u, const std::size_t & n_points, double * results) const;
+            ///@}
+
+            ///@name Transformations between u space and parameter space
+            ///@{
+            /*!
+             * Set the varied parameters to a point in u space.
+             *
+             * The generator values of all varied parameters are set at once, and each prior
+             * transforms them to parameter values through its inverse CDF.
+             *
+             * @param u   Array of varied_parameters().size() entries within the unit hypercube.
+             * @param par Array of varied_parameters().size() entries, into which the parameter values are written.
+             */
+            void set_from_u(const double * u, double * par);
+
+            /*!
+             * Set the varied parameters to a point in parameter space.
+             *
+             * The values of all varied parameters are set at once, and each prior transforms
+             * them to generator values through its CDF.
+             *
+             * @param par Array of varied_parameters().size() entries.
+             * @param u   Array of varied_parameters().size() entries, into which the generator values are written.
+             */
+            void set_from_par(const double * par, double * u);
             ///@}
 
             ///@name Accessors
@@ -123,6 +193,26 @@ namespace eos
             LogPosterior *
             private_clone() const;
 
+            /// Evaluate the Log(posterior) at a single point in u space.
+            double _evaluate_u(const double * u);
+
+            /// Retrieve the revision of the likelihood's configuration and the priors, at which clones are valid.
+            unsigned long _revision() const;
+
+            /*!
+             * Check out n clones for a parallel evaluation, reusing idle clones where possible.
+             *
+             * @param n        The number of clones.
+             * @param revision Receives the revision at which the clones are valid, see _revision().
+             */
+            std::vector<LogPosteriorPtr> _check_out_clones(const unsigned & n, unsigned long & revision) const;
+
+            /// Return clones after a parallel evaluation, unless the likelihood or the priors have changed in the meantime.
+            void _return_clones(std::vector<LogPosteriorPtr> & clones, const unsigned long & revision) const;
+
+            /// Bring the parameters of another LogPosterior to our current parameter point.
+            void _synchronize(LogPosterior & other) const;
+
             LogLikelihood _log_likelihood;
 
             Parameters _parameters;
@@ -138,6 +228,27 @@ namespace eos
 
             /// Parameters with priors
             std::vector<Parameter> _varied_parameters;
+
+            /// Idle clones used for parallel evaluations; copies of a LogPosterior do not share them
+            struct Clones
+            {
+                Mutex mutex;
+
+                std::vector<LogPosteriorPtr> idle;
+
+                /// The revision at which the idle clones are valid, see _revision()
+                unsigned long revision = 0;
+
+                Clones() = default;
+
+                Clones(const Clones &) :
+                    Clones()
+                {
+                }
+
+                Clones & operator= (const Clones &);
+            };
+            mutable Clones _clones;
     };
 
     extern template class WrappedForwardIterator<LogPosterior::PriorIteratorTag, const LogPriorPtr>;
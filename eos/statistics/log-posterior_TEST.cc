@@ -22,6 +22,9 @@
 
 #include <eos/statistics/log-posterior_TEST.hh>
 
+#include <cmath>
+#include <vector>
+
 using namespace test;
 using namespace eos;
 
@@ -122,6 +125,136 @@ class LogPosteriorTest :
                 TEST_CHECK_EQUAL(log_posterior.log_prior(), clone->log_prior());
             }
 
+            // gradient
+            {
+                LogPosterior log_posterior = make_log_posterior(false);
+
+                // add a parameter that none of the observables uses
+                log_posterior.add(LogPrior::CurtailedGauss(log_posterior.parameters(), "mass::c",
+                        ParameterRange{ 1.0, 2.0 }, 1.4, 1.5, 1.6));
+
+                // the posterior is a product of two gaussians, centered at 4.3 with variance 0.005,
+                // and at 1.5 with variance 0.01
+                log_posterior[0].set(4.35);
+                log_posterior[1].set(1.45);
+
+                auto gradient = log_posterior.gradient();
+                TEST_CHECK_EQUAL(gradient.size(), 2u);
+                TEST_CHECK_RELATIVE_ERROR(gradient[0], -10.0, 1e-6);
+                TEST_CHECK_RELATIVE_ERROR(gradient[1], +5.0,  1e-6);
+
+                // the parameter point is unchanged
+                TEST_CHECK_EQUAL(log_posterior[0].evaluate(), 4.35);
+                TEST_CHECK_EQUAL(log_posterior[1].evaluate(), 1.45);
+
+                // the clones follow subsequent changes of the parameter point
+                log_posterior[0].set(4.25);
+                gradient = log_posterior.gradient();
+                TEST_CHECK_RELATIVE_ERROR(gradient[0], +10.0, 1e-6);
+                TEST_CHECK_RELATIVE_ERROR(gradient[1], +5.0,  1e-6);
+
+                TEST_CHECK_THROWS(InternalError, log_posterior.gradient(0.0));
+            }
+
+            // the clones follow changes of the likelihood's configuration
+            {
+                LogPosterior log_posterior = make_log_posterior(false);
+                log_posterior[0].set(4.35);
+
+                auto gradient = log_posterior.gradient();
+                TEST_CHECK_RELATIVE_ERROR(gradient[0], -10.0, 1e-6);
+
+                // a second, identical measurement doubles the likelihood's contribution
+                LogLikelihood llh = log_posterior.log_likelihood();
+                llh.add(ObservablePtr(new ObservableStub(log_posterior.parameters(), "mass::b(MSbar)")), 4.1, 4.2, 4.3);
+
+                gradient = log_posterior.gradient();
+                TEST_CHECK_RELATIVE_ERROR(gradient[0], -25.0, 1e-6);
+
+                // copies do not share their clones
+                LogPosterior copy = log_posterior;
+                gradient = copy.gradient();
+                TEST_CHECK_RELATIVE_ERROR(gradient[0], -25.0, 1e-6);
+            }
+
+            // hessian
+            {
+                LogPosterior log_posterior = make_log_posterior(false);
+                log_posterior.add(LogPrior::CurtailedGauss(log_posterior.parameters(), "mass::c",
+                        ParameterRange{ 1.0, 2.0 }, 1.4, 1.5, 1.6));
+
+                log_posterior[0].set(4.35);
+                log_posterior[1].set(1.45);
+
+                auto hessian = log_posterior.hessian();
+                TEST_CHECK_EQUAL(hessian.size(), 4u);
+                TEST_CHECK_RELATIVE_ERROR(hessian[0], -200.0, 1e-5);
+                TEST_CHECK_RELATIVE_ERROR(hessian[3], -100.0, 1e-5);
+
+                // the parameters share neither a constraint nor a prior
+                TEST_CHECK_EQUAL(hessian[1], 0.0);
+                TEST_CHECK_EQUAL(hessian[2], 0.0);
+
+                // the parameter point is unchanged
+                TEST_CHECK_EQUAL(log_posterior[0].evaluate(), 4.35);
+                TEST_CHECK_EQUAL(log_posterior[1].evaluate(), 1.45);
+
+                TEST_CHECK_THROWS(InternalError, log_posterior.hessian(0.0));
+            }
+
+            // batched evaluation in u space
+            {
+                LogPosterior log_posterior = make_log_posterior(false);
+
+                std::vector<double> u;
+                for (unsigned i = 0 ; i < 100 ; ++i)
+                {
+                    u.push_back((i + 0.5) / 100.0);
+                }
+                u.push_back(-0.1);
+                u.push_back(+1.1);
+
+                std::vector<double> results(u.size());
+                log_posterior.evaluate_batch(u.data(), u.size(), results.data());
+
+                // compare with the serial evaluation
+                Parameter p = log_posterior[0];
+                for (unsigned i = 0 ; i < 100 ; ++i)
+                {
+                    p.set_generator(u[i]);
+                    for (auto prior = log_posterior.begin_priors(), prior_end = log_posterior.end_priors() ; prior != prior_end ; ++prior)
+                    {
+                        (*prior)->sample();
+                    }
+
+                    TEST_CHECK_NEARLY_EQUAL(results[i], log_posterior.evaluate(), eps);
+                }
+
+                // points outside the unit hypercube
+                TEST_CHECK(std::isinf(results[100]) && (results[100] < 0.0));
+                TEST_CHECK(std::isinf(results[101]) && (results[101] < 0.0));
+            }
+
+            // transformations between u space and parameter space
+            {
+                LogPosterior log_posterior = make_log_posterior(false);
+                log_posterior.add(LogPrior::Flat(log_posterior.parameters(), "mass::c", ParameterRange{ 1.0, 2.0 }));
+
+                const std::vector<double> u{ 0.3, 0.25 };
+                std::vector<double> par(2), u_roundtrip(2);
+
+                log_posterior.set_from_u(u.data(), par.data());
+                TEST_CHECK_EQUAL(par[0], log_posterior[0].evaluate());
+                TEST_CHECK_EQUAL(par[1], log_posterior[1].evaluate());
+                TEST_CHECK_RELATIVE_ERROR(par[1], 1.25, eps);
+                TEST_CHECK(par[0] < 4.4);
+
+                log_posterior.set_from_par(par.data(), u_roundtrip.data());
+                TEST_CHECK_NEARLY_EQUAL(u_roundtrip[0], u[0], 1e-10);
+                TEST_CHECK_NEARLY_EQUAL(u_roundtrip[1], u[1], 1e-10);
+                TEST_CHECK_EQUAL(u_roundtrip[0], log_posterior[0].evaluate_generator());
+            }
+
             // stop if prior undefined
             {
                 Parameters parameters = Parameters::Defaults();
@@ -144,6 +144,10 @@ namespace eos
                 {
                     return false;
                 }
+                virtual std::vector<ParameterRange> ranges() const
+                {
+                    return { _range };
+                }
         };
 
         /*!
@@ -281,6 +285,10 @@ namespace eos
                 {
                     return true;
                 }
+                virtual std::vector<ParameterRange> ranges() const
+                {
+                    return { _range };
+                }
         };
 
         /*!
@@ -365,6 +373,10 @@ namespace eos
                 {
                     return true;
                 }
+                virtual std::vector<ParameterRange> ranges() const
+                {
+                    return { _range };
+                }
         };
 
         /*!
@@ -619,6 +631,19 @@ namespace eos
                 {
                     return true;
                 }
+                virtual std::vector<ParameterRange> ranges() const
+                {
+                    // the support is infinite; use +/- 10 standard deviations around the mean instead
+                    std::vector<ParameterRange> result;
+                    for (unsigned i = 0 ; i < _dim ; ++i)
+                    {
+                        const double mean  = gsl_vector_get(_mean, i);
+                        const double sigma = std::sqrt(gsl_matrix_get(_covariance, i, i));
+                        result.emplace_back(mean - 10.0 * sigma, mean + 10.0 * sigma);
+                    }
+
+                    return result;
+                }
         };
     }
 
@@ -112,6 +112,15 @@ namespace eos
              * Return whether or not this prior is informative.
              */
             virtual bool informative() const = 0;
+
+            /*!
+             * Return the ranges of all varied parameters, in order of iteration.
+             *
+             * For priors with finite support, the ranges coincide with the support.
+             * For priors with infinite support, a range that covers all but a negligible
+             * part of the probability is returned instead.
+             */
+            virtual std::vector<ParameterRange> ranges() const = 0;
             ///@}
 
             ///@name Named constructors for 1D prior distributions with finite support
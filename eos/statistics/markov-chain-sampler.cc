@@ -0,0 +1,497 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2026 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <eos/maths/power-of.hh>
+#include <eos/statistics/markov-chain-sampler.hh>
+#include <eos/utils/exception.hh>
+#include <eos/utils/log.hh>
+#include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/stringify.hh>
+#include <eos/utils/thread_pool.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_linalg.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_randist.h>
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_vector.h>
+
+#include <config.h>
+
+#ifdef EOS_USE_GSL_LINALG_CHOLESKY_DECOMP
+#  if (EOS_USE_GSL_LINALG_CHOLESKY_DECOMP == 1)
+#    define GSL_LINALG_CHOLESKY_DECOMP gsl_linalg_cholesky_decomp
+#  else
+#    define GSL_LINALG_CHOLESKY_DECOMP gsl_linalg_cholesky_decomp1
+#  endif
+#else
+#  error EOS_USE_GSL_LINALG_CHOLESKY_DECOMP not defined.
+#endif
+
+namespace eos
+{
+    namespace impl
+    {
+        // A single adaptive Metropolis chain in u space
+        struct MarkovChain
+        {
+            LogPosteriorPtr log_posterior;
+
+            std::vector<Parameter> parameters;
+
+            const unsigned dim;
+
+            std::unique_ptr<gsl_rng, decltype(&gsl_rng_free)> rng;
+
+            // current state, its log(likelihood) as the u-space target density, and its log(posterior)
+            std::vector<double> u;
+            std::vector<double> x;
+            double log_target;
+            double log_posterior_value;
+
+            // proposal covariance, its scale factor, and the Cholesky factor of the scaled covariance
+            std::unique_ptr<gsl_matrix, decltype(&gsl_matrix_free)> covariance;
+            double scale;
+            std::unique_ptr<gsl_matrix, decltype(&gsl_matrix_free)> cholesky;
+
+            // temporary storage for the proposal
+            std::unique_ptr<gsl_vector, decltype(&gsl_vector_free)> z;
+            std::vector<double> u_proposed;
+
+            // number of adaptations carried out so far
+            unsigned adaptations;
+
+            // samples and acceptance count of the current run
+            std::vector<double> usamples;
+            std::vector<double> samples;
+            std::vector<double> log_posterior_values;
+            unsigned long accepted;
+            unsigned long proposed;
+
+            MarkovChain(const LogPosterior & original, const MarkovChainSampler::Config & config, const unsigned & index) :
+                log_posterior(original.clone()),
+                parameters(log_posterior->varied_parameters()),
+                dim(parameters.size()),
+                rng(gsl_rng_alloc(gsl_rng_mt19937), &gsl_rng_free),
+                u(dim),
+                x(dim),
+                log_target(-std::numeric_limits<double>::infinity()),
+                log_posterior_value(-std::numeric_limits<double>::infinity()),
+                covariance(gsl_matrix_calloc(dim, dim), &gsl_matrix_free),
+                scale(1.0),
+                cholesky(gsl_matrix_alloc(dim, dim), &gsl_matrix_free),
+                z(gsl_vector_alloc(dim), &gsl_vector_free),
+                u_proposed(dim),
+                adaptations(0),
+                accepted(0),
+                proposed(0)
+            {
+                gsl_rng_set(rng.get(), config.seed + index);
+
+                // 1 / 12 is the variance of U(0, 1)
+                for (unsigned i = 0 ; i < dim ; ++i)
+                {
+                    gsl_matrix_set(covariance.get(), i, i, config.cov_scale / 12.0);
+                }
+                decompose();
+
+                if (config.start_point.empty())
+                {
+                    for (unsigned i = 0 ; i < dim ; ++i)
+                    {
+                        u[i] = gsl_rng_uniform(rng.get());
+                    }
+                }
+                else
+                {
+                    u = config.start_point;
+                }
+                evaluate(u, log_target, log_posterior_value);
+                for (unsigned i = 0 ; i < dim ; ++i)
+                {
+                    x[i] = parameters[i].evaluate();
+                }
+            }
+
+            // compute the Cholesky factor of the scaled proposal covariance
+            void decompose()
+            {
+                gsl_matrix_memcpy(cholesky.get(), covariance.get());
+                gsl_matrix_scale(cholesky.get(), scale);
+                if (GSL_SUCCESS != GSL_LINALG_CHOLESKY_DECOMP(cholesky.get()))
+                {
+                    throw InternalError("MarkovChainSampler: Cholesky decomposition of the proposal covariance failed");
+                }
+            }
+
+            /*
+             * Evaluate the target density at a u-space point, which is transformed to parameter space via the priors.
+             *
+             * Since du = prior(x) dx, the posterior density in u space is the likelihood.
+             */
+            void evaluate(const std::vector<double> & point, double & target, double & posterior)
+            {
+                target    = -std::numeric_limits<double>::infinity();
+                posterior = -std::numeric_limits<double>::infinity();
+
+                for (unsigned i = 0 ; i < dim ; ++i)
+                {
+                    if ((point[i] < 0.0) || (point[i] > 1.0))
+                        return;
+
+                    parameters[i].set_generator(point[i]);
+                }
+
+                for (auto p = log_posterior->begin_priors(), p_end = log_posterior->end_priors() ; p != p_end ; ++p)
+                {
+                    (*p)->sample();
+                }
+
+                try
+                {
+                    target    = log_posterior->log_likelihood()();
+                    posterior = target + log_posterior->log_prior();
+                }
+                catch (Exception &)
+                {
+                    target    = -std::numeric_limits<double>::infinity();
+                    posterior = -std::numeric_limits<double>::infinity();
+                }
+            }
+
+            // draw one sample with a Gaussian proposal around the current state
+            void step()
+            {
+                for (unsigned i = 0 ; i < dim ; ++i)
+                {
+                    gsl_vector_set(z.get(), i, gsl_ran_ugaussian(rng.get()));
+                }
+                gsl_blas_dtrmv(CblasLower, CblasNoTrans, CblasNonUnit, cholesky.get(), z.get());
+
+                for (unsigned i = 0 ; i < dim ; ++i)
+                {
+                    u_proposed[i] = u[i] + gsl_vector_get(z.get(), i);
+                }
+
+                ++proposed;
+                double log_target_proposed, log_posterior_proposed;
+                evaluate(u_proposed, log_target_proposed, log_posterior_proposed);
+                if (std::log(gsl_rng_uniform_pos(rng.get())) < log_target_proposed - log_target)
+                {
+                    ++accepted;
+                    std::swap(u, u_proposed);
+                    log_target = log_target_proposed;
+                    log_posterior_value = log_posterior_proposed;
+                    for (unsigned i = 0 ; i < dim ; ++i)
+                    {
+                        x[i] = parameters[i].evaluate();
+                    }
+                }
+            }
+
+            // draw N * stride samples, and store every stride-th sample
+            void run(const unsigned & N, const unsigned & stride)
+            {
+                usamples.clear();
+                samples.clear();
+                log_posterior_values.clear();
+                usamples.reserve(N * dim);
+                samples.reserve(N * dim);
+                log_posterior_values.reserve(N);
+                accepted = 0;
+                proposed = 0;
+
+                for (unsigned i = 0 ; i < N ; ++i)
+                {
+                    for (unsigned s = 0 ; s < stride ; ++s)
+                    {
+                        step();
+                    }
+
+                    usamples.insert(usamples.end(), u.cbegin(), u.cend());
+                    samples.insert(samples.end(), x.cbegin(), x.cend());
+                    log_posterior_values.push_back(log_posterior_value);
+                }
+            }
+
+            // adapt the proposal covariance to the samples of the last run
+            void adapt()
+            {
+                const unsigned N = log_posterior_values.size();
+                if (N < 2)
+                    return;
+
+                std::vector<double> mean(dim, 0.0);
+                for (unsigned n = 0 ; n < N ; ++n)
+                {
+                    for (unsigned i = 0 ; i < dim ; ++i)
+                    {
+                        mean[i] += usamples[n * dim + i] / N;
+                    }
+                }
+
+                // the weight of the new estimate decreases with the number of adaptations
+                adaptations += 1;
+                const double gamma = std::pow(adaptations, -0.5);
+
+                std::unique_ptr<gsl_matrix, decltype(&gsl_matrix_free)> previous(gsl_matrix_alloc(dim, dim), &gsl_matrix_free);
+                gsl_matrix_memcpy(previous.get(), covariance.get());
+
+                for (unsigned i = 0 ; i < dim ; ++i)
+                {
+                    for (unsigned j = 0 ; j <= i ; ++j)
+                    {
+                        double c = 0.0;
+                        for (unsigned n = 0 ; n < N ; ++n)
+                        {
+                            c += (usamples[n * dim + i] - mean[i]) * (usamples[n * dim + j] - mean[j]);
+                        }
+                        c /= (N - 1);
+
+                        const double value = (1.0 - gamma) * gsl_matrix_get(previous.get(), i, j) + gamma * c;
+                        gsl_matrix_set(covariance.get(), i, j, value);
+                        gsl_matrix_set(covariance.get(), j, i, value);
+                    }
+                }
+
+                // steer the acceptance rate into the interval [0.15, 0.35]
+                const double acceptance_rate = double(accepted) / proposed;
+                if (acceptance_rate > 0.35)
+                    scale = std::min(scale * 1.5, 100.0);
+                else if (acceptance_rate < 0.15)
+                    scale = std::max(scale / 1.5, 1.0e-4);
+
+                try
+                {
+                    decompose();
+                }
+                catch (InternalError &)
+                {
+                    // the covariance estimate is degenerate, e.g. if hardly any proposal has been accepted;
+                    // keep the previous covariance and only adjust the scale
+                    gsl_matrix_memcpy(covariance.get(), previous.get());
+                    decompose();
+                }
+            }
+        };
+    }
+
+    template <>
+    struct Implementation<MarkovChainSampler>
+    {
+        MarkovChainSampler::Config config;
+
+        std::vector<std::unique_ptr<impl::MarkovChain>> chains;
+
+        unsigned dim;
+
+        Implementation(const LogPosterior & log_posterior, const MarkovChainSampler::Config & config) :
+            config(config),
+            dim(log_posterior.varied_parameters().size())
+        {
+            if (0 == config.number_of_chains)
+                throw InternalError("MarkovChainSampler: at least one chain is required");
+
+            if (0 == config.stride)
+                throw InternalError("MarkovChainSampler: the stride must be positive");
+
+            if (! (config.cov_scale > 0.0))
+                throw InternalError("MarkovChainSampler: the scale of the initial proposal covariance must be positive");
+
+            if ((! config.start_point.empty()) && (config.start_point.size() != dim))
+                throw InternalError("MarkovChainSampler: the starting point has " + stringify(config.start_point.size())
+                        + " entries, but " + stringify(dim) + " parameters are varied");
+
+            for (unsigned i = 0 ; i < config.number_of_chains ; ++i)
+            {
+                chains.push_back(std::make_unique<impl::MarkovChain>(log_posterior, config, i));
+            }
+        }
+
+        // run all chains in parallel
+        void run(const unsigned & N, const unsigned & stride)
+        {
+            TaskGroup tasks;
+            for (auto & chain : chains)
+            {
+                impl::MarkovChain * c = chain.get();
+                tasks.run([c, N, stride] () { c->run(N, stride); });
+            }
+            tasks.wait();
+        }
+
+        std::vector<double> r_values() const
+        {
+            const unsigned m = chains.size();
+            const unsigned n = chains.front()->log_posterior_values.size();
+
+            std::vector<double> result(dim, std::numeric_limits<double>::quiet_NaN());
+            if ((m < 2) || (n < 2))
+                return result;
+
+            for (unsigned i = 0 ; i < dim ; ++i)
+            {
+                // means and variances of the individual chains
+                std::vector<double> means(m, 0.0), variances(m, 0.0);
+                for (unsigned k = 0 ; k < m ; ++k)
+                {
+                    const auto & usamples = chains[k]->usamples;
+                    for (unsigned s = 0 ; s < n ; ++s)
+                    {
+                        means[k] += usamples[s * dim + i] / n;
+                    }
+                    for (unsigned s = 0 ; s < n ; ++s)
+                    {
+                        variances[k] += power_of<2>(usamples[s * dim + i] - means[k]) / (n - 1);
+                    }
+                }
+
+                // within-chain variance W and between-chain variance B / n
+                double W = 0.0, mean = 0.0, B_over_n = 0.0;
+                for (unsigned k = 0 ; k < m ; ++k)
+                {
+                    W    += variances[k] / m;
+                    mean += means[k] / m;
+                }
+                for (unsigned k = 0 ; k < m ; ++k)
+                {
+                    B_over_n += power_of<2>(means[k] - mean) / (m - 1);
+                }
+
+                const double V = (n - 1.0) / n * W + (m + 1.0) / m * B_over_n;
+                result[i] = std::sqrt(V / W);
+            }
+
+            return result;
+        }
+
+        void log_r_values(const std::string & phase) const
+        {
+            if (chains.size() < 2)
+                return;
+
+            const auto r = r_values();
+            const double r_max = *std::max_element(r.cbegin(), r.cend());
+            Log::instance()->message("MarkovChainSampler.run", ll_informational)
+                << phase << ": largest R value is " << r_max;
+        }
+
+        void log_acceptance_rates(const std::string & phase) const
+        {
+            for (unsigned k = 0 ; k < chains.size() ; ++k)
+            {
+                if (0 == chains[k]->proposed)
+                    continue;
+
+                Log::instance()->message("MarkovChainSampler.run", ll_informational)
+                    << phase << ": acceptance rate of chain " << k << " is "
+                    << 100.0 * chains[k]->accepted / chains[k]->proposed << "%";
+            }
+        }
+    };
+
+    MarkovChainSampler::Config
+    MarkovChainSampler::Config::Default()
+    {
+        return Config{ 4, 1701, 3, 150, 1000, 5, 0.1, {} };
+    }
+
+    MarkovChainSampler::MarkovChainSampler(const LogPosterior & log_posterior, const MarkovChainSampler::Config & config) :
+        PrivateImplementationPattern<MarkovChainSampler>(new Implementation<MarkovChainSampler>(log_posterior, config))
+    {
+    }
+
+    MarkovChainSampler::~MarkovChainSampler()
+    {
+    }
+
+    void
+    MarkovChainSampler::run()
+    {
+        for (unsigned i = 0 ; i < _imp->config.preruns ; ++i)
+        {
+            const std::string phase = "Prerun " + stringify(i);
+            _imp->run(_imp->config.prerun_samples, 1);
+            _imp->log_acceptance_rates(phase);
+            _imp->log_r_values(phase);
+
+            for (auto & chain : _imp->chains)
+            {
+                chain->adapt();
+            }
+        }
+
+        _imp->run(_imp->config.samples, _imp->config.stride);
+        _imp->log_acceptance_rates("Main run");
+        _imp->log_r_values("Main run");
+    }
+
+    unsigned
+    MarkovChainSampler::number_of_chains() const
+    {
+        return _imp->chains.size();
+    }
+
+    unsigned
+    MarkovChainSampler::dimension() const
+    {
+        return _imp->dim;
+    }
+
+    const std::vector<double> &
+    MarkovChainSampler::samples(const unsigned & chain) const
+    {
+        return _imp->chains.at(chain)->samples;
+    }
+
+    const std::vector<double> &
+    MarkovChainSampler::usamples(const unsigned & chain) const
+    {
+        return _imp->chains.at(chain)->usamples;
+    }
+
+    const std::vector<double> &
+    MarkovChainSampler::log_posterior_values(const unsigned & chain) const
+    {
+        return _imp->chains.at(chain)->log_posterior_values;
+    }
+
+    std::vector<double>
+    MarkovChainSampler::acceptance_rates() const
+    {
+        std::vector<double> result;
+        for (const auto & chain : _imp->chains)
+        {
+            result.push_back(chain->proposed > 0 ? double(chain->accepted) / chain->proposed : 0.0);
+        }
+
+        return result;
+    }
+
+    std::vector<double>
+    MarkovChainSampler::r_values() const
+    {
+        return _imp->r_values();
+    }
+}
@@ -0,0 +1,124 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2026 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_EOS_STATISTICS_MARKOV_CHAIN_SAMPLER_HH
+#define EOS_GUARD_EOS_STATISTICS_MARKOV_CHAIN_SAMPLER_HH 1
+
+#include <eos/statistics/log-posterior.hh>
+#include <eos/utils/private_implementation_pattern.hh>
+
+#include <vector>
+
+namespace eos
+{
+    /*!
+     * Samples from a LogPosterior with several independent, adaptive Metropolis chains.
+     *
+     * The chains operate in the space of the priors' cumulative probabilities (u space),
+     * u in [0, 1] for each varied parameter. The priors are absorbed into the transformation,
+     * and the likelihood remains as the target density. Each chain uses its own clone of the
+     * LogPosterior and its own random number stream, and runs on a separate thread.
+     * The proposal covariance is adapted after each prerun.
+     */
+    class MarkovChainSampler :
+        public PrivateImplementationPattern<MarkovChainSampler>
+    {
+        public:
+            struct Config;
+
+            ///@name Basic Functions
+            ///@{
+            /*!
+             * Constructor.
+             *
+             * @param log_posterior The LogPosterior from which samples shall be drawn.
+             * @param config        The configuration of the sampler.
+             */
+            MarkovChainSampler(const LogPosterior & log_posterior, const Config & config);
+
+            /// Destructor.
+            ~MarkovChainSampler();
+
+            /// Run all preruns, adapting the proposals, followed by the main run.
+            void run();
+            ///@}
+
+            ///@name Results
+            ///@{
+            /// Retrieve the number of chains.
+            unsigned number_of_chains() const;
+
+            /// Retrieve the number of varied parameters.
+            unsigned dimension() const;
+
+            /// Retrieve the parameter samples of one chain, as a row-major matrix of N x dimension() entries.
+            const std::vector<double> & samples(const unsigned & chain) const;
+
+            /// Retrieve the u-space samples of one chain, as a row-major matrix of N x dimension() entries.
+            const std::vector<double> & usamples(const unsigned & chain) const;
+
+            /// Retrieve the values of the log(posterior) for the samples of one chain.
+            const std::vector<double> & log_posterior_values(const unsigned & chain) const;
+
+            /// Retrieve the acceptance rate of each chain in the main run.
+            std::vector<double> acceptance_rates() const;
+
+            /*!
+             * Retrieve the Gelman-Rubin R value for each varied parameter, as obtained from
+             * the u-space samples of the main run. At least two chains are required.
+             */
+            std::vector<double> r_values() const;
+            ///@}
+    };
+
+    /*!
+     * Configuration of a MarkovChainSampler.
+     */
+    struct MarkovChainSampler::Config
+    {
+        /// Number of independent chains
+        unsigned number_of_chains;
+
+        /// Seed of the first chain's random number stream; chain i uses seed + i
+        unsigned long seed;
+
+        /// Number of preruns, after each of which the proposals are adapted
+        unsigned preruns;
+
+        /// Number of samples in each prerun
+        unsigned prerun_samples;
+
+        /// Number of samples to be stored per chain in the main run
+        unsigned samples;
+
+        /// Number of samples drawn per stored sample in the main run
+        unsigned stride;
+
+        /// Scale factor for the initial proposal covariance; must be positive
+        double cov_scale;
+
+        /// Optional u-space starting point for all chains; random starting points are used if empty
+        std::vector<double> start_point;
+
+        /// Named constructor with the default values
+        static Config Default();
+    };
+}
+
+#endif
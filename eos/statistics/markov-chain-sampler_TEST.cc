@@ -0,0 +1,114 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2026 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <config.h>
+
+#include <eos/statistics/log-posterior_TEST.hh>
+#include <eos/statistics/markov-chain-sampler.hh>
+
+#include <cmath>
+
+using namespace test;
+using namespace eos;
+
+class MarkovChainSamplerTest :
+    public TestCase
+{
+    public:
+        MarkovChainSamplerTest() :
+            TestCase("markov_chain_sampler_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            // sample from a gaussian posterior with mean 4.3 and standard deviation 0.0707
+            {
+                LogPosterior log_posterior = make_log_posterior(false);
+
+                auto config = MarkovChainSampler::Config::Default();
+                config.number_of_chains = 4;
+                config.seed             = 1234;
+                config.preruns          = 3;
+                config.prerun_samples   = 500;
+                config.samples          = 2000;
+                config.stride           = 5;
+
+                MarkovChainSampler sampler(log_posterior, config);
+                sampler.run();
+
+                TEST_CHECK_EQUAL(sampler.number_of_chains(), 4u);
+                TEST_CHECK_EQUAL(sampler.dimension(),        1u);
+
+                double mean = 0.0, variance = 0.0;
+                for (unsigned k = 0 ; k < sampler.number_of_chains() ; ++k)
+                {
+                    TEST_CHECK_EQUAL(sampler.samples(k).size(),              2000u);
+                    TEST_CHECK_EQUAL(sampler.usamples(k).size(),             2000u);
+                    TEST_CHECK_EQUAL(sampler.log_posterior_values(k).size(), 2000u);
+
+                    for (const auto & x : sampler.samples(k))
+                    {
+                        mean     += x / 8000.0;
+                        variance += (x - 4.3) * (x - 4.3) / 8000.0;
+                    }
+                }
+                TEST_CHECK_NEARLY_EQUAL(mean,                 4.3,    0.01);
+                TEST_CHECK_NEARLY_EQUAL(std::sqrt(variance),  0.0707, 0.01);
+
+                for (const auto & rate : sampler.acceptance_rates())
+                {
+                    TEST_CHECK(rate > 0.1);
+                    TEST_CHECK(rate < 0.9);
+                }
+
+                const auto r_values = sampler.r_values();
+                TEST_CHECK_EQUAL(r_values.size(), 1u);
+                TEST_CHECK(r_values[0] < 1.1);
+
+                // the chains use independent random number streams
+                TEST_CHECK(sampler.usamples(0) != sampler.usamples(1));
+
+                // the results are reproducible for a fixed seed
+                MarkovChainSampler other(log_posterior, config);
+                other.run();
+                for (unsigned k = 0 ; k < sampler.number_of_chains() ; ++k)
+                {
+                    TEST_CHECK(sampler.usamples(k) == other.usamples(k));
+                }
+            }
+
+            // invalid configurations
+            {
+                LogPosterior log_posterior = make_log_posterior(false);
+
+                auto config = MarkovChainSampler::Config::Default();
+                config.number_of_chains = 0;
+                TEST_CHECK_THROWS(InternalError, MarkovChainSampler(log_posterior, config));
+
+                config = MarkovChainSampler::Config::Default();
+                config.start_point = { 0.5, 0.5 };
+                TEST_CHECK_THROWS(InternalError, MarkovChainSampler(log_posterior, config));
+
+                config = MarkovChainSampler::Config::Default();
+                config.cov_scale = 0.0;
+                TEST_CHECK_THROWS(InternalError, MarkovChainSampler(log_posterior, config));
+            }
+        }
+} markov_chain_sampler_test;
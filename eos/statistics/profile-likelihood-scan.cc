@@ -0,0 +1,490 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2026 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <eos/statistics/log-likelihood.hh>
+#include <eos/statistics/log-prior.hh>
+#include <eos/statistics/profile-likelihood-scan.hh>
+#include <eos/utils/exception.hh>
+#include <eos/utils/log.hh>
+#include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/stringify.hh>
+#include <eos/utils/thread_pool.hh>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <tuple>
+
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_multimin.h>
+#include <gsl/gsl_vector.h>
+
+namespace eos
+{
+    namespace impl
+    {
+        // Maximises the Log(posterior) of one clone with respect to the profiled parameters
+        struct ProfileMinimizer
+        {
+            LogPosteriorPtr log_posterior;
+
+            const ProfileLikelihoodScan::Config & config;
+
+            std::vector<Parameter> parameters_of_interest;
+
+            std::vector<Parameter> profiled_parameters;
+
+            std::vector<ParameterRange> ranges;
+
+            gsl_multimin_fminimizer * minimizer;
+
+            gsl_vector * start;
+
+            gsl_vector * steps;
+
+            ProfileMinimizer(const LogPosterior & original, const ProfileLikelihoodScan::Config & config,
+                    const std::vector<std::string> & names, const std::vector<unsigned> & profiled_indices,
+                    const std::vector<ParameterRange> & ranges) :
+                log_posterior(original.clone()),
+                config(config),
+                ranges(ranges),
+                minimizer(nullptr),
+                start(nullptr),
+                steps(nullptr)
+            {
+                for (const auto & name : names)
+                {
+                    parameters_of_interest.push_back(log_posterior->parameters()[name]);
+                }
+
+                for (const auto & i : profiled_indices)
+                {
+                    profiled_parameters.push_back(log_posterior->varied_parameters()[i]);
+                }
+
+                if (! profiled_parameters.empty())
+                {
+                    minimizer = gsl_multimin_fminimizer_alloc(gsl_multimin_fminimizer_nmsimplex2, profiled_parameters.size());
+                    start     = gsl_vector_alloc(profiled_parameters.size());
+                    steps     = gsl_vector_alloc(profiled_parameters.size());
+                }
+            }
+
+            ~ProfileMinimizer()
+            {
+                if (minimizer)
+                {
+                    gsl_vector_free(steps);
+                    gsl_vector_free(start);
+                    gsl_multimin_fminimizer_free(minimizer);
+                }
+            }
+
+            // Move the profiled parameters to a point given in units of the prior ranges; returns the squared distance to the ranges
+            double move(const gsl_vector * y)
+            {
+                double distance = 0.0;
+
+                for (unsigned i = 0 ; i < profiled_parameters.size() ; ++i)
+                {
+                    const double y_i = gsl_vector_get(y, i);
+                    const double clamped = std::min(std::max(y_i, 0.0), 1.0);
+                    distance += (y_i - clamped) * (y_i - clamped);
+
+                    profiled_parameters[i].set(ranges[i].min + clamped * (ranges[i].max - ranges[i].min));
+                }
+
+                return distance;
+            }
+
+            // The objective is -log(posterior), extended beyond the prior ranges by a quadratic penalty
+            static double objective(const gsl_vector * y, void * data)
+            {
+                auto * self = static_cast<ProfileMinimizer *>(data);
+
+                const double distance = self->move(y);
+
+                // failed evaluations are treated as points of vanishing posterior density
+                double value;
+                try
+                {
+                    value = -self->log_posterior->log_posterior();
+                }
+                catch (Exception &)
+                {
+                    return std::numeric_limits<double>::max() / 4.0;
+                }
+
+                if (! std::isfinite(value))
+                    return std::numeric_limits<double>::max() / 4.0;
+
+                return value + 1.0e4 * distance;
+            }
+
+            // Set the parameters of interest to the values of a grid point
+            void set_point(const double * point)
+            {
+                for (unsigned k = 0 ; k < parameters_of_interest.size() ; ++k)
+                {
+                    parameters_of_interest[k].set(point[k]);
+                }
+            }
+
+            // Evaluate -log(posterior) with the profiled parameters at the given values
+            double evaluate(const double * values)
+            {
+                for (unsigned i = 0 ; i < profiled_parameters.size() ; ++i)
+                {
+                    profiled_parameters[i].set(values[i]);
+                }
+
+                double value;
+                try
+                {
+                    value = -log_posterior->log_posterior();
+                }
+                catch (Exception &)
+                {
+                    return std::numeric_limits<double>::infinity();
+                }
+
+                return std::isfinite(value) ? value : std::numeric_limits<double>::infinity();
+            }
+
+            /*
+             * Minimise -log(posterior) at the current point, starting from the given values of the profiled parameters.
+             * The optimal values replace the starting values. Returns the log(posterior) and the log(likelihood) at the optimum.
+             */
+            std::pair<double, double> minimize(double * values)
+            {
+                const unsigned dim = profiled_parameters.size();
+
+                if (0 != dim)
+                {
+                    for (unsigned i = 0 ; i < dim ; ++i)
+                    {
+                        const double y_i = (values[i] - ranges[i].min) / (ranges[i].max - ranges[i].min);
+                        gsl_vector_set(start, i, std::min(std::max(y_i, 0.0), 1.0));
+                        gsl_vector_set(steps, i, config.initial_step);
+                    }
+
+                    gsl_multimin_function f;
+                    f.n      = dim;
+                    f.f      = &ProfileMinimizer::objective;
+                    f.params = this;
+
+                    gsl_multimin_fminimizer_set(minimizer, &f, start, steps);
+                    for (unsigned iteration = 0 ; iteration < config.max_iterations ; ++iteration)
+                    {
+                        if (GSL_SUCCESS != gsl_multimin_fminimizer_iterate(minimizer))
+                            break;
+
+                        if (GSL_SUCCESS == gsl_multimin_test_size(gsl_multimin_fminimizer_size(minimizer), config.tolerance))
+                            break;
+                    }
+
+                    move(gsl_multimin_fminimizer_x(minimizer));
+                    for (unsigned i = 0 ; i < dim ; ++i)
+                    {
+                        values[i] = profiled_parameters[i].evaluate();
+                    }
+                }
+
+                try
+                {
+                    const double log_posterior_value = log_posterior->log_posterior();
+
+                    return std::make_pair(log_posterior_value, log_posterior_value - log_posterior->log_prior());
+                }
+                catch (Exception &)
+                {
+                    // a failed evaluation must not abort the entire scan
+                    return std::make_pair(-std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity());
+                }
+            }
+        };
+    }
+
+    template <>
+    struct Implementation<ProfileLikelihoodScan>
+    {
+        static constexpr unsigned segment_size = 16;
+
+        LogPosteriorPtr log_posterior;
+
+        std::vector<ProfileLikelihoodScan::Axis> axes;
+
+        ProfileLikelihoodScan::Config config;
+
+        // indices of the profiled parameters among the varied parameters, and their prior ranges
+        std::vector<unsigned> profiled_indices;
+        std::vector<ParameterRange> ranges;
+
+        // the rows of the grid, as ranges of point indices
+        std::vector<std::pair<unsigned, unsigned>> rows;
+
+        unsigned n_points;
+
+        std::vector<double> points;
+        std::vector<double> profiled_values;
+        std::vector<double> log_posterior_values;
+        std::vector<double> log_likelihood_values;
+
+        Implementation(const LogPosterior & log_posterior, const std::vector<ProfileLikelihoodScan::Axis> & axes, const ProfileLikelihoodScan::Config & config) :
+            log_posterior(log_posterior.clone()),
+            axes(axes),
+            config(config),
+            n_points(1)
+        {
+            if (axes.empty() || (axes.size() > 2))
+                throw InternalError("ProfileLikelihoodScan: one or two parameters of interest are required, but "
+                        + stringify(axes.size()) + " were specified");
+
+            for (const auto & axis : axes)
+            {
+                if (0 == axis.points)
+                    throw InternalError("ProfileLikelihoodScan: the axis of '" + axis.name + "' has no points");
+
+                n_points *= axis.points;
+            }
+
+            // the priors' ranges, in the same order as the varied parameters
+            std::vector<ParameterRange> all_ranges;
+            for (auto p = this->log_posterior->begin_priors(), p_end = this->log_posterior->end_priors() ; p != p_end ; ++p)
+            {
+                const auto prior_ranges = (*p)->ranges();
+                all_ranges.insert(all_ranges.end(), prior_ranges.begin(), prior_ranges.end());
+            }
+
+            const auto & varied_parameters = this->log_posterior->varied_parameters();
+            for (unsigned i = 0 ; i < varied_parameters.size() ; ++i)
+            {
+                const bool is_of_interest = std::any_of(axes.cbegin(), axes.cend(),
+                        [&] (const ProfileLikelihoodScan::Axis & axis) { return axis.name == varied_parameters[i].name(); });
+                if (is_of_interest)
+                    continue;
+
+                profiled_indices.push_back(i);
+                ranges.push_back(all_ranges[i]);
+            }
+
+            // enumerate the grid points, with the last axis varying fastest
+            points.resize(n_points * axes.size());
+            for (unsigned n = 0 ; n < n_points ; ++n)
+            {
+                unsigned index = n;
+                for (unsigned k = axes.size() ; k-- > 0 ; )
+                {
+                    const auto & axis = axes[k];
+                    const unsigned i = index % axis.points;
+                    index /= axis.points;
+
+                    points[n * axes.size() + k] = (1 == axis.points) ? axis.min : axis.min + (axis.max - axis.min) * i / (axis.points - 1);
+                }
+            }
+
+            // divide the grid into rows of neighbouring points
+            const unsigned row_length = (2 == axes.size()) ? axes[1].points : segment_size;
+            for (unsigned first = 0 ; first < n_points ; first += row_length)
+            {
+                rows.push_back(std::make_pair(first, std::min(first + row_length, n_points)));
+            }
+        }
+
+        // Return the indices of the neighbouring grid points
+        std::vector<unsigned> neighbours(const unsigned & n) const
+        {
+            std::vector<unsigned> result;
+
+            const unsigned inner = axes.back().points;
+            const unsigned j = n % inner;
+            if (j > 0)
+                result.push_back(n - 1);
+            if (j + 1 < inner)
+                result.push_back(n + 1);
+
+            if (2 == axes.size())
+            {
+                if (n >= inner)
+                    result.push_back(n - inner);
+                if (n + inner < n_points)
+                    result.push_back(n + inner);
+            }
+
+            return result;
+        }
+
+        // Process all rows in parallel, with one minimizer per job
+        template <typename Function_>
+        void for_each_row(const Function_ & f)
+        {
+            const unsigned n_jobs = std::min<unsigned>(ThreadPool::instance()->number_of_threads(), rows.size());
+            std::atomic<unsigned> next_row(0);
+
+            std::vector<std::unique_ptr<impl::ProfileMinimizer>> minimizers;
+            std::vector<std::string> names;
+            for (const auto & axis : axes)
+            {
+                names.push_back(axis.name);
+            }
+            for (unsigned j = 0 ; j < n_jobs ; ++j)
+            {
+                minimizers.push_back(std::make_unique<impl::ProfileMinimizer>(*log_posterior, config, names, profiled_indices, ranges));
+            }
+
+            TaskGroup tasks;
+            for (unsigned j = 0 ; j < n_jobs ; ++j)
+            {
+                impl::ProfileMinimizer * minimizer = minimizers[j].get();
+                tasks.run([this, minimizer, &f, &next_row] () {
+                    for (unsigned r = next_row++ ; r < rows.size() ; r = next_row++)
+                    {
+                        f(*minimizer, rows[r]);
+                    }
+                });
+            }
+            tasks.wait();
+        }
+
+        void run()
+        {
+            const unsigned dim = profiled_indices.size();
+
+            std::vector<double> initial_values;
+            for (const auto & i : profiled_indices)
+            {
+                initial_values.push_back(log_posterior->varied_parameters()[i].evaluate());
+            }
+
+            profiled_values.assign(n_points * dim, 0.0);
+            log_posterior_values.assign(n_points, -std::numeric_limits<double>::infinity());
+            log_likelihood_values.assign(n_points, -std::numeric_limits<double>::infinity());
+
+            // walk along each row, starting each point from the optimum of its predecessor
+            for_each_row([&] (impl::ProfileMinimizer & minimizer, const std::pair<unsigned, unsigned> & row) {
+                std::vector<double> values = initial_values;
+                for (unsigned n = row.first ; n < row.second ; ++n)
+                {
+                    minimizer.set_point(&points[n * axes.size()]);
+                    std::tie(log_posterior_values[n], log_likelihood_values[n]) = minimizer.minimize(values.data());
+                    std::copy(values.cbegin(), values.cend(), profiled_values.begin() + n * dim);
+                }
+            });
+
+            if (0 == dim)
+                return;
+
+            // restart each point from the optima of its neighbours, if they promise a better value
+            const std::vector<double> previous_values = profiled_values;
+            const std::vector<double> previous_log_posterior_values = log_posterior_values;
+            for_each_row([&] (impl::ProfileMinimizer & minimizer, const std::pair<unsigned, unsigned> & row) {
+                std::vector<double> values(dim);
+                for (unsigned n = row.first ; n < row.second ; ++n)
+                {
+                    minimizer.set_point(&points[n * axes.size()]);
+                    for (const auto & m : neighbours(n))
+                    {
+                        const double * neighbour_values = &previous_values[m * dim];
+                        if (-minimizer.evaluate(neighbour_values) <= previous_log_posterior_values[n])
+                            continue;
+
+                        std::copy(neighbour_values, neighbour_values + dim, values.begin());
+                        const auto result = minimizer.minimize(values.data());
+                        if (result.first <= log_posterior_values[n])
+                            continue;
+
+                        std::tie(log_posterior_values[n], log_likelihood_values[n]) = result;
+                        std::copy(values.cbegin(), values.cend(), profiled_values.begin() + n * dim);
+                    }
+                }
+            });
+        }
+    };
+
+    ProfileLikelihoodScan::ProfileLikelihoodScan(const LogPosterior & log_posterior, const std::vector<Axis> & axes, const Config & config) :
+        PrivateImplementationPattern<ProfileLikelihoodScan>(new Implementation<ProfileLikelihoodScan>(log_posterior, axes, config))
+    {
+    }
+
+    ProfileLikelihoodScan::~ProfileLikelihoodScan()
+    {
+    }
+
+    void
+    ProfileLikelihoodScan::run()
+    {
+        Log::instance()->message("ProfileLikelihoodScan::run", ll_informational)
+            << "Profiling " << _imp->profiled_indices.size() << " parameter(s) at " << _imp->n_points << " grid point(s)";
+
+        _imp->run();
+
+        Log::instance()->message("ProfileLikelihoodScan::run", ll_informational)
+            << "Maximal log(posterior) on the grid: " << *std::max_element(_imp->log_posterior_values.cbegin(), _imp->log_posterior_values.cend());
+    }
+
+    unsigned
+    ProfileLikelihoodScan::number_of_points() const
+    {
+        return _imp->n_points;
+    }
+
+    std::vector<std::string>
+    ProfileLikelihoodScan::profiled_parameter_names() const
+    {
+        std::vector<std::string> result;
+        for (const auto & i : _imp->profiled_indices)
+        {
+            result.push_back(_imp->log_posterior->varied_parameters()[i].name());
+        }
+
+        return result;
+    }
+
+    const std::vector<double> &
+    ProfileLikelihoodScan::points() const
+    {
+        return _imp->points;
+    }
+
+    const std::vector<double> &
+    ProfileLikelihoodScan::profiled_values() const
+    {
+        return _imp->profiled_values;
+    }
+
+    const std::vector<double> &
+    ProfileLikelihoodScan::log_posterior_values() const
+    {
+        return _imp->log_posterior_values;
+    }
+
+    const std::vector<double> &
+    ProfileLikelihoodScan::log_likelihood_values() const
+    {
+        return _imp->log_likelihood_values;
+    }
+
+    ProfileLikelihoodScan::Config
+    ProfileLikelihoodScan::Config::Default()
+    {
+        return Config{ 2000, 1.0e-6, 0.05 };
+    }
+}
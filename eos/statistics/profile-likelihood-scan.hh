@@ -0,0 +1,130 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2026 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_EOS_STATISTICS_PROFILE_LIKELIHOOD_SCAN_HH
+#define EOS_GUARD_EOS_STATISTICS_PROFILE_LIKELIHOOD_SCAN_HH 1
+
+#include <eos/statistics/log-posterior.hh>
+#include <eos/utils/private_implementation_pattern.hh>
+
+#include <string>
+#include <vector>
+
+namespace eos
+{
+    /*!
+     * Scans the profile of a LogPosterior on a grid in one or two parameters of interest.
+     *
+     * At each grid point, the parameters of interest are fixed and the Log(posterior) is
+     * maximised with respect to all other varied parameters, using a Nelder-Mead simplex
+     * within the ranges of their priors. The grid is divided into rows, i.e., lines along the last
+     * parameter of interest, or segments of up to 16 points for a single parameter of interest.
+     * The rows are distributed across the thread pool, with one clone of the LogPosterior per job.
+     * Within a row, each point starts from the optimum of its predecessor. A subsequent pass
+     * restarts each point from the optima of its neighbours, whenever they promise a better value.
+     * The results do not depend on the number of threads.
+     */
+    class ProfileLikelihoodScan :
+        public PrivateImplementationPattern<ProfileLikelihoodScan>
+    {
+        public:
+            struct Axis;
+            struct Config;
+
+            ///@name Basic Functions
+            ///@{
+            /*!
+             * Constructor.
+             *
+             * @param log_posterior The LogPosterior whose profile shall be scanned.
+             * @param axes          One or two axes of the grid, one per parameter of interest.
+             * @param config        The configuration of the scan.
+             */
+            ProfileLikelihoodScan(const LogPosterior & log_posterior, const std::vector<Axis> & axes, const Config & config);
+
+            /// Destructor.
+            ~ProfileLikelihoodScan();
+
+            /// Profile the LogPosterior at all grid points.
+            void run();
+            ///@}
+
+            ///@name Results
+            ///@{
+            /// Retrieve the number of grid points.
+            unsigned number_of_points() const;
+
+            /// Retrieve the names of the profiled parameters, i.e., of all varied parameters that are not parameters of interest.
+            std::vector<std::string> profiled_parameter_names() const;
+
+            /*!
+             * Retrieve the values of the parameters of interest, as a row-major matrix of
+             * number_of_points() x axes entries. The last axis varies fastest.
+             */
+            const std::vector<double> & points() const;
+
+            /// Retrieve the optimal values of the profiled parameters, as a row-major matrix with one row per grid point.
+            const std::vector<double> & profiled_values() const;
+
+            /// Retrieve the maximal values of the Log(posterior), one per grid point.
+            const std::vector<double> & log_posterior_values() const;
+
+            /// Retrieve the values of the Log(likelihood) at the optima, one per grid point.
+            const std::vector<double> & log_likelihood_values() const;
+            ///@}
+    };
+
+    /*!
+     * Axis of the grid of a ProfileLikelihoodScan.
+     */
+    struct ProfileLikelihoodScan::Axis
+    {
+        /// Name of the parameter of interest
+        std::string name;
+
+        /// Smallest value on the axis
+        double min;
+
+        /// Largest value on the axis
+        double max;
+
+        /// Number of equidistant values on the axis, including both end points
+        unsigned points;
+    };
+
+    /*!
+     * Configuration of a ProfileLikelihoodScan.
+     */
+    struct ProfileLikelihoodScan::Config
+    {
+        /// Maximal number of simplex iterations per minimisation
+        unsigned max_iterations;
+
+        /// Size of the simplex at convergence, relative to the ranges of the priors
+        double tolerance;
+
+        /// Size of the initial simplex, relative to the ranges of the priors
+        double initial_step;
+
+        /// Named constructor with the default values
+        static Config Default();
+    };
+}
+
+#endif
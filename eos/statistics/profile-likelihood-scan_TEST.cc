@@ -0,0 +1,157 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2026 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include <eos/statistics/log-posterior_TEST.hh>
+#include <eos/statistics/profile-likelihood-scan.hh>
+
+#include <cmath>
+
+using namespace test;
+using namespace eos;
+
+// Predicts m_b, but fails to evaluate for m_b > 4.3
+struct ThrowingTestObservable :
+    public Observable
+{
+    QualifiedName n;
+    Parameters p;
+    Kinematics k;
+    Parameter m_b;
+
+    ThrowingTestObservable(const Parameters & p) :
+        n("mass::b(MSbar)"),
+        p(p),
+        m_b(p["mass::b(MSbar)"])
+    {
+    }
+
+    virtual const QualifiedName & name() const { return n; }
+    virtual Parameters parameters() { return p; }
+    virtual Kinematics kinematics() { return k; }
+    virtual Options options() { return Options(); }
+    virtual ObservablePtr clone() const { return ObservablePtr(new ThrowingTestObservable(p.clone())); }
+    virtual ObservablePtr clone(const Parameters & p) const { return ObservablePtr(new ThrowingTestObservable(p)); }
+
+    virtual double evaluate() const
+    {
+        if (m_b() > 4.3 + 1.0e-10)
+            throw InternalError("ThrowingTestObservable: m_b is out of range");
+
+        return m_b();
+    }
+};
+
+class ProfileLikelihoodScanTest :
+    public TestCase
+{
+    public:
+        ProfileLikelihoodScanTest() :
+            TestCase("profile_likelihood_scan_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            // gaussian likelihoods for m_b = 4.2 +- 0.1 and m_c = 1.30 +- 0.05, and flat priors
+            Parameters parameters = Parameters::Defaults();
+            LogLikelihood llh(parameters);
+            llh.add(ObservablePtr(new ObservableStub(parameters, "mass::b(MSbar)")), 4.1, 4.2, 4.3);
+            llh.add(ObservablePtr(new ObservableStub(parameters, "mass::c")), 1.25, 1.30, 1.35);
+
+            LogPosterior log_posterior(llh);
+            log_posterior.add(LogPrior::Flat(parameters, "mass::b(MSbar)", ParameterRange{ 3.7, 4.9 }));
+            log_posterior.add(LogPrior::Flat(parameters, "mass::c", ParameterRange{ 1.0, 1.6 }));
+
+            // start the profiled parameter away from its optimum
+            parameters["mass::c"] = 1.55;
+
+            // one parameter of interest
+            {
+                ProfileLikelihoodScan scan(log_posterior, { { "mass::b(MSbar)", 4.0, 4.4, 21 } }, ProfileLikelihoodScan::Config::Default());
+                scan.run();
+
+                TEST_CHECK_EQUAL(scan.number_of_points(), 21u);
+                TEST_CHECK(scan.profiled_parameter_names() == std::vector<std::string>{ "mass::c" });
+                TEST_CHECK_EQUAL(scan.points().size(),          21u);
+                TEST_CHECK_EQUAL(scan.profiled_values().size(), 21u);
+
+                const double reference = scan.log_posterior_values()[10];
+                for (unsigned n = 0 ; n < scan.number_of_points() ; ++n)
+                {
+                    const double m_b = scan.points()[n];
+                    TEST_CHECK_NEARLY_EQUAL(m_b,                        4.0 + 0.02 * n,                                   1e-12);
+                    TEST_CHECK_NEARLY_EQUAL(scan.profiled_values()[n],  1.30,                                             1e-4);
+                    TEST_CHECK_NEARLY_EQUAL(scan.log_posterior_values()[n] - reference, -0.5 * std::pow((m_b - 4.2) / 0.1, 2), 1e-5);
+                    TEST_CHECK_NEARLY_EQUAL(scan.log_posterior_values()[n] - scan.log_likelihood_values()[n],
+                            log_posterior.log_prior(),                                                                    1e-10);
+                }
+
+                // the scan does not modify the parameters of the LogPosterior
+                TEST_CHECK_EQUAL(parameters["mass::c"].evaluate(), 1.55);
+            }
+
+            // two parameters of interest, leaving nothing to profile
+            {
+                ProfileLikelihoodScan scan(log_posterior, { { "mass::b(MSbar)", 4.0, 4.4, 3 }, { "mass::c", 1.2, 1.4, 5 } },
+                        ProfileLikelihoodScan::Config::Default());
+                scan.run();
+
+                TEST_CHECK_EQUAL(scan.number_of_points(), 15u);
+                TEST_CHECK(scan.profiled_parameter_names().empty());
+                TEST_CHECK_EQUAL(scan.points().size(), 30u);
+
+                // the last axis varies fastest
+                TEST_CHECK_NEARLY_EQUAL(scan.points()[2 * 6 + 0], 4.2,  1e-12);
+                TEST_CHECK_NEARLY_EQUAL(scan.points()[2 * 6 + 1], 1.25, 1e-12);
+                TEST_CHECK(scan.log_posterior_values()[7] > scan.log_posterior_values()[6]);
+                TEST_CHECK(scan.log_posterior_values()[7] > scan.log_posterior_values()[2]);
+            }
+
+            // failed evaluations only affect their own grid points
+            {
+                Parameters parameters = Parameters::Defaults();
+                LogLikelihood llh(parameters);
+                llh.add(ObservablePtr(new ThrowingTestObservable(parameters)), 4.1, 4.2, 4.3);
+                llh.add(ObservablePtr(new ObservableStub(parameters, "mass::c")), 1.25, 1.30, 1.35);
+
+                LogPosterior log_posterior(llh);
+                log_posterior.add(LogPrior::Flat(parameters, "mass::b(MSbar)", ParameterRange{ 3.7, 4.9 }));
+                log_posterior.add(LogPrior::Flat(parameters, "mass::c", ParameterRange{ 1.0, 1.6 }));
+
+                ProfileLikelihoodScan scan(log_posterior, { { "mass::b(MSbar)", 4.0, 4.4, 5 } }, ProfileLikelihoodScan::Config::Default());
+                TEST_CHECK_NO_THROW(scan.run());
+
+                for (unsigned n = 0 ; n < 4 ; ++n)
+                {
+                    TEST_CHECK(std::isfinite(scan.log_posterior_values()[n]));
+                    TEST_CHECK_NEARLY_EQUAL(scan.profiled_values()[n], 1.30, 1e-4);
+                }
+                TEST_CHECK(std::isinf(scan.log_posterior_values()[4]) && (scan.log_posterior_values()[4] < 0.0));
+                TEST_CHECK(std::isinf(scan.log_likelihood_values()[4]) && (scan.log_likelihood_values()[4] < 0.0));
+            }
+
+            // invalid axes
+            {
+                TEST_CHECK_THROWS(InternalError, ProfileLikelihoodScan(log_posterior, { }, ProfileLikelihoodScan::Config::Default()));
+                TEST_CHECK_THROWS(InternalError, ProfileLikelihoodScan(log_posterior, { { "mass::b(MSbar)", 4.0, 4.4, 0 } },
+                            ProfileLikelihoodScan::Config::Default()));
+            }
+        }
+} profile_likelihood_scan_test;
@@ -26,6 +26,8 @@
 #include <eos/utils/reference-name.hh>
 #include <eos/utils/concrete-cacheable-observable.hh>
 #include <eos/utils/concrete_observable.hh>
+#include <eos/utils/expression.hh>
+#include <eos/utils/expression-observable.hh>
 #include <eos/utils/observable_cache.hh>
 
 using namespace test;
@@ -279,10 +281,19 @@ class CacheableObservableTest :
                 &TestRegularObservableProvider::evaluate1,
                 std::make_tuple("q2")
             ));
-            ObservableCache::Id regular_observable_id [[maybe_unused]];
+            ObservableCache::Id regular_observable_id;
 
             TEST_CHECK_NO_THROW(regular_observable_id = cache.add(regular_observable));
 
+            // adding an identical, but distinct observable object yields the same id
+            ObservablePtr regular_observable_copy(new TestRegularObservable("test::regular_observable(q2)", p, Kinematics({{"q2", 2.0}}), Options(),
+                &TestRegularObservableProvider::evaluate1,
+                std::make_tuple("q2")
+            ));
+            cache_size = cache.size();
+            TEST_CHECK_EQUAL(regular_observable_id, cache.add(regular_observable_copy));
+            TEST_CHECK_EQUAL(cache.size(), cache_size);
+
 
             // Add a third, different, cacheable observable
             ObservablePtr cacheable_observable3(new TestCacheableObservable("test::cacheable_observable3(q2)", p, Kinematics({{"q2", 6.0}}), Options(),
@@ -290,7 +301,7 @@ class CacheableObservableTest :
                 &TestCacheableObservableProvider::evaluate2,
                 std::make_tuple("q2")
             ));
-            ObservableCache::Id cacheable_observable3_id [[maybe_unused]];
+            ObservableCache::Id cacheable_observable3_id;
 
             TEST_CHECK_NO_THROW(cacheable_observable3_id = cache.add(cacheable_observable3));
 
@@ -299,6 +310,95 @@ class CacheableObservableTest :
             TEST_CHECK_NO_THROW(cache.update());
             TEST_CHECK_EQUAL(cache[cacheable_observable_id],  cache[cacheable_observable2_id]);
 
+            // Test incremental cache evaluation
+            const double regular_prediction = cache[regular_observable_id];
+            const double cacheable3_prediction = cache[cacheable_observable3_id];
+            p["mass::B_u"] = 5.0;
+            TEST_CHECK_NO_THROW(cache.update());
+            TEST_CHECK_NEARLY_EQUAL(cache[cacheable_observable_id],  5.0 - 2.0 * 2.0, 1.e-5);
+            TEST_CHECK_EQUAL(cache[cacheable_observable_id],  cache[cacheable_observable2_id]);
+            TEST_CHECK_EQUAL(cache[regular_observable_id],    regular_prediction);
+            TEST_CHECK_EQUAL(cache[cacheable_observable3_id], cacheable3_prediction);
+
+            cacheable_observable3->kinematics().set("q2", 3.0);
+            TEST_CHECK_NO_THROW(cache.update());
+            TEST_CHECK_NEARLY_EQUAL(cache[cacheable_observable3_id], 9.0, 1.e-5);
+
+            p["mass::B_u"] = 5.27934;
+            TEST_CHECK_NO_THROW(cache.update());
+            TEST_CHECK_NEARLY_EQUAL(cache[cacheable_observable_id],  5.27934 - 2.0 * 2.0, 1.e-5);
+
+            // Test evaluation of expressions that rely on other observables in the cache
+            {
+                using namespace eos::exp;
+
+                Expression e = BinaryExpression('*', ObservableNameExpression("mass::tau", KinematicsSpecification()), KinematicVariableNameExpression("q2"));
+                ObservablePtr expression_observable(new ExpressionObservable("test::expression_observable(q2)", p, Kinematics({{"q2", 2.0}}), Options(), e));
+                ObservableCache::Id expression_observable_id;
+
+                TEST_CHECK_NO_THROW(expression_observable_id = cache.add(expression_observable));
+                TEST_CHECK_NO_THROW(cache.update());
+                TEST_CHECK_NEARLY_EQUAL(cache[expression_observable_id], 2.0 * p["mass::tau"](), 1.e-5);
+
+                p["mass::tau"] = 2.0;
+                TEST_CHECK_NO_THROW(cache.update());
+                TEST_CHECK_NEARLY_EQUAL(cache[expression_observable_id], 4.0, 1.e-5);
+
+                cache.observable(expression_observable_id)->kinematics().set("q2", 3.0);
+                TEST_CHECK_NO_THROW(cache.update());
+                TEST_CHECK_NEARLY_EQUAL(cache[expression_observable_id], 6.0, 1.e-5);
+            }
+
+            // Test profiling of the cache evaluation
+            {
+                TEST_CHECK_EQUAL(cache.profile().size(), cache.size());
+                TEST_CHECK_EQUAL(cache.profile()[cacheable_observable_id].calls, 0u);
+
+                cache.enable_profiling();
+                p["mass::B_u"] = 5.1;
+                TEST_CHECK_NO_THROW(cache.update());
+                p["mass::B_u"] = 5.27934;
+                TEST_CHECK_NO_THROW(cache.update());
+
+                auto profile = cache.profile();
+                TEST_CHECK_EQUAL(profile.size(),                              cache.size());
+                TEST_CHECK_EQUAL(profile[cacheable_observable_id].name,       "test::cacheable_observable1(q2)[q2=2];");
+                TEST_CHECK_EQUAL(profile[cacheable_observable_id].calls,      2u);
+                TEST_CHECK_EQUAL(profile[cacheable_observable2_id].calls,     2u);
+                TEST_CHECK_EQUAL(profile[cacheable_observable_id].exceptions, 0u);
+                TEST_CHECK(profile[cacheable_observable_id].time >= 0.0);
+
+                // no further information is recorded once profiling is disabled
+                cache.enable_profiling(false);
+                p["mass::B_u"] = 5.1;
+                TEST_CHECK_NO_THROW(cache.update());
+                p["mass::B_u"] = 5.27934;
+                TEST_CHECK_NO_THROW(cache.update());
+                TEST_CHECK_EQUAL(cache.profile()[cacheable_observable_id].calls, 2u);
+
+                cache.reset_profile();
+                TEST_CHECK_EQUAL(cache.profile()[cacheable_observable_id].calls, 0u);
+            }
+
+            // Test batched cache evaluation
+            {
+                const std::vector<Parameter::Id> ids{ p["mass::B_u"].id() };
+                const std::vector<double> points{ 5.0, 5.1, 5.2, 5.3, 5.4 };
+                std::vector<double> predictions(points.size() * cache.size());
+
+                TEST_CHECK_NO_THROW(cache.update_batch(ids, points.data(), points.size(), 1, predictions.data()));
+
+                for (unsigned i = 0 ; i < points.size() ; ++i)
+                {
+                    TEST_CHECK_NEARLY_EQUAL(predictions[i * cache.size() + cacheable_observable_id],  points[i] - 2.0 * 2.0, 1.e-5);
+                    TEST_CHECK_NEARLY_EQUAL(predictions[i * cache.size() + cacheable_observable2_id], points[i] - 2.0 * 2.0, 1.e-5);
+                    TEST_CHECK_NEARLY_EQUAL(predictions[i * cache.size() + cacheable_observable3_id], 9.0,                   1.e-5);
+                }
+
+                // the predictions of the cache itself remain unchanged
+                TEST_CHECK_NEARLY_EQUAL(cache[cacheable_observable_id],  5.27934 - 2.0 * 2.0, 1.e-5);
+            }
+
             // Test cache cloning
             ObservableCache cache2(p);
             TEST_CHECK_NO_THROW(cache2 = cache.clone(p));
@@ -29,11 +29,35 @@
 
 #include <array>
 #include <functional>
+#include <memory>
 #include <string>
 #include <tuple>
+#include <typeindex>
 
 namespace eos
 {
+    namespace impl
+    {
+        /*!
+         * Retrieve a Decay_ object for the given parameters and options.
+         *
+         * All observables that use the same Parameters object and the same options
+         * share one Decay_ object, which is constructed on first use. The ObservableCache
+         * might evaluate these observables concurrently. Hence, Decay_'s const member
+         * functions must not modify shared state without synchronisation.
+         */
+        template <typename Decay_>
+        std::shared_ptr<Decay_> make_shared_decay(const Parameters & parameters, const Options & options)
+        {
+            auto factory = [&parameters, &options] () -> std::shared_ptr<void>
+            {
+                return std::make_shared<Decay_>(parameters, options);
+            };
+
+            return std::static_pointer_cast<Decay_>(parameters.shared_object(std::type_index(typeid(Decay_)), options.as_string(), factory));
+        }
+    }
+
     template <typename Decay_, typename ... Args_>
     class ConcreteObservable :
         public Observable
@@ -49,7 +73,7 @@ namespace eos
 
             Options _options;
 
-            Decay_ _decay;
+            std::shared_ptr<Decay_> _decay;
 
             std::function<double (const Decay_ *, const Args_ & ...)> _function;
 
@@ -68,12 +92,12 @@ namespace eos
                 _parameters(parameters),
                 _kinematics(kinematics),
                 _options(options),
-                _decay(parameters, options),
+                _decay(impl::make_shared_decay<Decay_>(parameters, options)),
                 _function(function),
                 _kinematics_names(kinematics_names),
-                _argument_tuple(impl::TupleMaker<sizeof...(Args_)>::make(_kinematics, _kinematics_names, &_decay))
+                _argument_tuple(impl::TupleMaker<sizeof...(Args_)>::make(_kinematics, _kinematics_names, _decay.get()))
             {
-                uses(_decay);
+                uses(*_decay);
                 uses(Decay_::references);
             }
 
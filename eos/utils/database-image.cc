@@ -0,0 +1,524 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2026 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <eos/utils/database-image.hh>
+#include <eos/utils/log.hh>
+#include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/stringify.hh>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+#include <yaml-cpp/yaml.h>
+
+namespace fs = boost::filesystem;
+
+namespace eos
+{
+    namespace impl
+    {
+        // Layout of the image file:
+        //  - the header,
+        //  - (number of strings + 1) offsets into the string data,
+        //  - the words,
+        //  - the string data.
+        struct DatabaseImageHeader
+        {
+            char magic[8];
+
+            std::uint64_t byte_order;
+
+            std::uint64_t version;
+
+            std::uint64_t fingerprint;
+
+            std::uint64_t number_of_strings;
+
+            std::uint64_t number_of_words;
+
+            std::uint64_t size_of_string_data;
+        };
+
+        static const char database_image_magic[8] = { 'E', 'O', 'S', 'D', 'B', 'I', 'M', 'G' };
+
+        static const std::uint64_t database_image_byte_order = 0x0102030405060708ull;
+
+        // tags of the encoded YAML nodes
+        enum class NodeTag : std::uint64_t
+        {
+            null     = 0,
+            scalar   = 1,
+            sequence = 2,
+            map      = 3
+        };
+
+        // 64-bit FNV-1a hash
+        struct FNV1a
+        {
+            std::uint64_t value = 0xcbf29ce484222325ull;
+
+            void update(const char * data, const std::size_t & size)
+            {
+                for (std::size_t i = 0 ; i < size ; ++i)
+                {
+                    value ^= static_cast<unsigned char>(data[i]);
+                    value *= 0x100000001b3ull;
+                }
+            }
+        };
+    }
+
+    DatabaseImageError::DatabaseImageError(const std::string & file, const std::string & msg) throw () :
+        Exception("Cannot write database image '" + file + "': " + msg)
+    {
+    }
+
+    template <>
+    struct Implementation<DatabaseImageWriter>
+    {
+        std::vector<std::string> strings;
+
+        std::unordered_map<std::string, std::uint64_t> string_indices;
+
+        std::vector<std::uint64_t> words;
+
+        std::uint64_t intern(const std::string & value)
+        {
+            auto i = string_indices.find(value);
+            if (string_indices.end() != i)
+                return i->second;
+
+            const std::uint64_t index = strings.size();
+            strings.push_back(value);
+            string_indices[value] = index;
+
+            return index;
+        }
+    };
+
+    DatabaseImageWriter::DatabaseImageWriter() :
+        PrivateImplementationPattern<DatabaseImageWriter>(new Implementation<DatabaseImageWriter>())
+    {
+    }
+
+    DatabaseImageWriter::~DatabaseImageWriter()
+    {
+    }
+
+    std::size_t
+    DatabaseImageWriter::position() const
+    {
+        return _imp->words.size();
+    }
+
+    void
+    DatabaseImageWriter::write_uint(const std::uint64_t & value)
+    {
+        _imp->words.push_back(value);
+    }
+
+    void
+    DatabaseImageWriter::write_double(const double & value)
+    {
+        std::uint64_t word;
+        std::memcpy(&word, &value, sizeof(word));
+        _imp->words.push_back(word);
+    }
+
+    void
+    DatabaseImageWriter::write_string(const std::string & value)
+    {
+        _imp->words.push_back(_imp->intern(value));
+    }
+
+    void
+    DatabaseImageWriter::set_uint(const std::size_t & position, const std::uint64_t & value)
+    {
+        if (position >= _imp->words.size())
+            throw InternalError("DatabaseImageWriter::set_uint: position '" + stringify(position) + "' is out of range");
+
+        _imp->words[position] = value;
+    }
+
+    void
+    DatabaseImageWriter::write_node(const YAML::Node & node)
+    {
+        using impl::NodeTag;
+
+        switch (node.Type())
+        {
+            case YAML::NodeType::Scalar:
+                write_uint(static_cast<std::uint64_t>(NodeTag::scalar));
+                write_string(node.Scalar());
+                break;
+
+            case YAML::NodeType::Sequence:
+                write_uint(static_cast<std::uint64_t>(NodeTag::sequence));
+                write_uint(node.size());
+                for (auto && child : node)
+                {
+                    write_node(child);
+                }
+                break;
+
+            case YAML::NodeType::Map:
+                write_uint(static_cast<std::uint64_t>(NodeTag::map));
+                write_uint(node.size());
+                for (auto && child : node)
+                {
+                    write_node(child.first);
+                    write_node(child.second);
+                }
+                break;
+
+            default:
+                write_uint(static_cast<std::uint64_t>(NodeTag::null));
+        }
+    }
+
+    void
+    DatabaseImageWriter::save(const std::string & file, const std::uint64_t & fingerprint) const
+    {
+        impl::DatabaseImageHeader header;
+        std::memcpy(header.magic, impl::database_image_magic, sizeof(header.magic));
+        header.byte_order          = impl::database_image_byte_order;
+        header.version             = DatabaseImage::version;
+        header.fingerprint         = fingerprint;
+        header.number_of_strings   = _imp->strings.size();
+        header.number_of_words     = _imp->words.size();
+        header.size_of_string_data = 0;
+
+        std::vector<std::uint64_t> offsets;
+        offsets.reserve(_imp->strings.size() + 1);
+        for (const auto & s : _imp->strings)
+        {
+            offsets.push_back(header.size_of_string_data);
+            header.size_of_string_data += s.size();
+        }
+        offsets.push_back(header.size_of_string_data);
+
+        // write to a temporary file first, so that concurrent readers never see a partial image
+        const std::string temporary = file + ".tmp" + stringify(::getpid());
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            if (! out)
+                throw DatabaseImageError(file, "cannot open '" + temporary + "' for writing");
+
+            out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char *>(offsets.data()), offsets.size() * sizeof(std::uint64_t));
+            out.write(reinterpret_cast<const char *>(_imp->words.data()), _imp->words.size() * sizeof(std::uint64_t));
+            for (const auto & s : _imp->strings)
+            {
+                out.write(s.data(), s.size());
+            }
+
+            if (! out)
+                throw DatabaseImageError(file, "error while writing '" + temporary + "'");
+        }
+
+        if (0 != std::rename(temporary.c_str(), file.c_str()))
+        {
+            std::remove(temporary.c_str());
+            throw DatabaseImageError(file, "cannot rename '" + temporary + "'");
+        }
+    }
+
+    template <>
+    struct Implementation<DatabaseImage>
+    {
+        void * address;
+
+        std::size_t length;
+
+        const std::uint64_t * offsets;
+
+        const std::uint64_t * words;
+
+        const char * string_data;
+
+        std::uint64_t number_of_strings, number_of_words;
+
+        Implementation(void * address, const std::size_t & length) :
+            address(address),
+            length(length)
+        {
+            const auto * header = static_cast<const impl::DatabaseImageHeader *>(address);
+            number_of_strings = header->number_of_strings;
+            number_of_words   = header->number_of_words;
+
+            offsets     = reinterpret_cast<const std::uint64_t *>(static_cast<const char *>(address) + sizeof(impl::DatabaseImageHeader));
+            words       = offsets + number_of_strings + 1;
+            string_data = reinterpret_cast<const char *>(words + number_of_words);
+        }
+
+        ~Implementation()
+        {
+            ::munmap(address, length);
+        }
+    };
+
+    const std::uint64_t DatabaseImage::version = 2;
+
+    DatabaseImage::DatabaseImage(Implementation<DatabaseImage> * imp) :
+        PrivateImplementationPattern<DatabaseImage>(imp)
+    {
+    }
+
+    DatabaseImage::~DatabaseImage()
+    {
+    }
+
+    std::shared_ptr<const DatabaseImage>
+    DatabaseImage::open(const std::string & file, const std::uint64_t & fingerprint)
+    {
+        if (std::getenv("EOS_IGNORE_DATABASE_IMAGES"))
+            return nullptr;
+
+        int fd = ::open(file.c_str(), O_RDONLY);
+        if (fd < 0)
+            return nullptr;
+
+        struct stat status;
+        if ((0 != ::fstat(fd, &status)) || (static_cast<std::size_t>(status.st_size) < sizeof(impl::DatabaseImageHeader)))
+        {
+            ::close(fd);
+            return nullptr;
+        }
+
+        const std::size_t length = status.st_size;
+        void * address = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+
+        if (MAP_FAILED == address)
+            return nullptr;
+
+        const auto * header = static_cast<const impl::DatabaseImageHeader *>(address);
+
+        std::string reason;
+        LogLevel level = ll_informational;
+        if (0 != std::memcmp(header->magic, impl::database_image_magic, sizeof(header->magic)))
+        {
+            reason = "is not a database image";
+        }
+        else if ((impl::database_image_byte_order != header->byte_order) || (DatabaseImage::version != header->version))
+        {
+            reason = "has been compiled for another platform or another version of EOS";
+        }
+        else if (length != sizeof(impl::DatabaseImageHeader) + (header->number_of_strings + 1 + header->number_of_words) * sizeof(std::uint64_t)
+                + header->size_of_string_data)
+        {
+            reason = "is truncated";
+        }
+        else if (fingerprint != header->fingerprint)
+        {
+            // the source files have changed since the image was compiled; loading them is much slower
+            reason = "is stale; recompile it with eos-compile-database-images";
+            level = ll_warning;
+        }
+
+        if (! reason.empty())
+        {
+            Log::instance()->message("DatabaseImage::open", level)
+                << "Ignoring database image '" << file << "', since it " << reason;
+
+            ::munmap(address, length);
+            return nullptr;
+        }
+
+        return std::make_shared<const DatabaseImage>(new Implementation<DatabaseImage>(address, length));
+    }
+
+    std::uint64_t
+    DatabaseImage::fingerprint(const std::string & directory, const std::string & extension)
+    {
+        std::vector<fs::path> files;
+        if (fs::is_directory(directory))
+        {
+            for (fs::directory_iterator f(directory), f_end ; f != f_end ; ++f)
+            {
+                if (! fs::is_regular_file(fs::status(f->path())))
+                    continue;
+
+                if (extension != f->path().extension().string())
+                    continue;
+
+                files.push_back(f->path());
+            }
+        }
+        std::sort(files.begin(), files.end());
+
+        impl::FNV1a hash;
+        for (const auto & file : files)
+        {
+            const std::string name = file.filename().string();
+            hash.update(name.c_str(), name.size() + 1);
+
+            std::ifstream in(file.string(), std::ios::binary);
+            const std::string contents{ std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>() };
+            hash.update(contents.data(), contents.size());
+        }
+
+        return hash.value;
+    }
+
+    std::size_t
+    DatabaseImage::size() const
+    {
+        return _imp->number_of_words;
+    }
+
+    std::string_view
+    DatabaseImage::string(const std::uint64_t & index) const
+    {
+        if (index >= _imp->number_of_strings)
+            throw InternalError("DatabaseImage::string: index '" + stringify(index) + "' is out of range");
+
+        return std::string_view(_imp->string_data + _imp->offsets[index], _imp->offsets[index + 1] - _imp->offsets[index]);
+    }
+
+    DatabaseImage::Cursor
+    DatabaseImage::cursor(const std::size_t & position) const
+    {
+        return Cursor(this, _imp->words, position, _imp->number_of_words);
+    }
+
+    DatabaseImage::Cursor::Cursor(const DatabaseImage * image, const std::uint64_t * words, const std::size_t & position, const std::size_t & size) :
+        _image(image),
+        _words(words),
+        _position(position),
+        _size(size)
+    {
+    }
+
+    const std::uint64_t &
+    DatabaseImage::Cursor::_next()
+    {
+        if (_position >= _size)
+            throw InternalError("DatabaseImage::Cursor: attempted to read beyond the end of the image");
+
+        return _words[_position++];
+    }
+
+    std::uint64_t
+    DatabaseImage::Cursor::read_uint()
+    {
+        return _next();
+    }
+
+    double
+    DatabaseImage::Cursor::read_double()
+    {
+        double result;
+        std::memcpy(&result, &_next(), sizeof(result));
+
+        return result;
+    }
+
+    std::string_view
+    DatabaseImage::Cursor::read_string()
+    {
+        return _image->string(_next());
+    }
+
+    YAML::Node
+    DatabaseImage::Cursor::read_node()
+    {
+        using impl::NodeTag;
+
+        switch (static_cast<NodeTag>(read_uint()))
+        {
+            case NodeTag::null:
+                return YAML::Node(YAML::NodeType::Null);
+
+            case NodeTag::scalar:
+                return YAML::Node(std::string(read_string()));
+
+            case NodeTag::sequence:
+            {
+                YAML::Node result(YAML::NodeType::Sequence);
+                for (std::uint64_t i = 0, n = read_uint() ; i < n ; ++i)
+                {
+                    result.push_back(read_node());
+                }
+
+                return result;
+            }
+
+            case NodeTag::map:
+            {
+                YAML::Node result(YAML::NodeType::Map);
+                for (std::uint64_t i = 0, n = read_uint() ; i < n ; ++i)
+                {
+                    YAML::Node key = read_node();
+                    result.force_insert(key, read_node());
+                }
+
+                return result;
+            }
+        }
+
+        throw InternalError("DatabaseImage::Cursor::read_node: encountered an invalid node tag");
+    }
+
+    void
+    DatabaseImage::Cursor::skip_node()
+    {
+        using impl::NodeTag;
+
+        switch (static_cast<NodeTag>(read_uint()))
+        {
+            case NodeTag::null:
+                return;
+
+            case NodeTag::scalar:
+                _next();
+                return;
+
+            case NodeTag::sequence:
+                for (std::uint64_t i = 0, n = read_uint() ; i < n ; ++i)
+                {
+                    skip_node();
+                }
+                return;
+
+            case NodeTag::map:
+                for (std::uint64_t i = 0, n = read_uint() ; i < n ; ++i)
+                {
+                    skip_node();
+                    skip_node();
+                }
+                return;
+        }
+
+        throw InternalError("DatabaseImage::Cursor::skip_node: encountered an invalid node tag");
+    }
+}
@@ -0,0 +1,198 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2026 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_EOS_UTILS_DATABASE_IMAGE_HH
+#define EOS_GUARD_EOS_UTILS_DATABASE_IMAGE_HH 1
+
+#include <eos/utils/exception.hh>
+#include <eos/utils/private_implementation_pattern.hh>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+// forward declaration
+namespace YAML
+{
+    class Node;
+}
+
+namespace eos
+{
+    /*!
+     * DatabaseImageError is thrown when a database image cannot be written.
+     */
+    struct DatabaseImageError :
+        public Exception
+    {
+        DatabaseImageError(const std::string & file, const std::string & msg) throw ();
+    };
+
+    /*!
+     * Compiles a binary database image.
+     *
+     * An image consists of a table of interned strings and a sequence of 64-bit words. The words
+     * encode unsigned integers, floating-point numbers, references into the string table, and
+     * YAML nodes. The image is specific to the platform on which it has been compiled.
+     */
+    class DatabaseImageWriter :
+        public PrivateImplementationPattern<DatabaseImageWriter>
+    {
+        public:
+            ///@name Basic Functions
+            ///@{
+            /// Constructor.
+            DatabaseImageWriter();
+
+            /// Destructor.
+            ~DatabaseImageWriter();
+            ///@}
+
+            ///@name Composition
+            ///@{
+            /// Retrieve the number of words written so far, i.e., the position of the next word.
+            std::size_t position() const;
+
+            /// Append an unsigned integer.
+            void write_uint(const std::uint64_t & value);
+
+            /// Append a floating-point number.
+            void write_double(const double & value);
+
+            /// Append a string, which is interned into the string table.
+            void write_string(const std::string & value);
+
+            /// Append a YAML node and all its children. Scalars are stored verbatim.
+            void write_node(const YAML::Node & node);
+
+            /// Overwrite a previously written unsigned integer, e.g., to resolve a forward reference.
+            void set_uint(const std::size_t & position, const std::uint64_t & value);
+            ///@}
+
+            /*!
+             * Save the image to a file.
+             *
+             * The file is replaced atomically.
+             *
+             * @param file        The name of the image file.
+             * @param fingerprint The fingerprint of the image's source files, see DatabaseImage::fingerprint().
+             */
+            void save(const std::string & file, const std::uint64_t & fingerprint) const;
+    };
+
+    /*!
+     * A read-only, memory-mapped binary database image.
+     */
+    class DatabaseImage :
+        public PrivateImplementationPattern<DatabaseImage>
+    {
+        public:
+            class Cursor;
+
+            /// The version of the image format.
+            static const std::uint64_t version;
+
+            ///@name Basic Functions
+            ///@{
+            /// Constructor. Use DatabaseImage::open() instead.
+            DatabaseImage(Implementation<DatabaseImage> * imp);
+
+            /// Destructor. Unmaps the image.
+            ~DatabaseImage();
+
+            /*!
+             * Map an image file into memory.
+             *
+             * Returns nullptr if the image file does not exist, if it has been compiled for another
+             * version of the image format or another platform, or if its fingerprint differs from
+             * the given one. In the latter case the image is stale, i.e., its source files have changed.
+             * Returns nullptr as well if the environment variable EOS_IGNORE_DATABASE_IMAGES is set.
+             *
+             * @param file        The name of the image file.
+             * @param fingerprint The expected fingerprint of the image's source files.
+             */
+            static std::shared_ptr<const DatabaseImage> open(const std::string & file, const std::uint64_t & fingerprint);
+
+            /*!
+             * Compute the fingerprint of all source files in a directory.
+             *
+             * The fingerprint is a hash of the names and the contents of all regular files with the
+             * given extension, in lexicographical order of their names.
+             *
+             * @param directory The directory that contains the source files.
+             * @param extension The extension of the source files, e.g., ".yaml".
+             */
+            static std::uint64_t fingerprint(const std::string & directory, const std::string & extension);
+            ///@}
+
+            ///@name Access
+            ///@{
+            /// Retrieve the number of words.
+            std::size_t size() const;
+
+            /// Retrieve a string from the string table.
+            std::string_view string(const std::uint64_t & index) const;
+
+            /// Retrieve a cursor at the given word position.
+            Cursor cursor(const std::size_t & position = 0) const;
+            ///@}
+    };
+
+    /*!
+     * Reads the words of a DatabaseImage sequentially.
+     *
+     * The cursor does not own the image; the image must outlive it.
+     */
+    class DatabaseImage::Cursor
+    {
+        private:
+            const DatabaseImage * _image;
+
+            const std::uint64_t * _words;
+
+            std::size_t _position, _size;
+
+            const std::uint64_t & _next();
+
+        public:
+            Cursor(const DatabaseImage * image, const std::uint64_t * words, const std::size_t & position, const std::size_t & size);
+
+            /// Retrieve the position of the next word.
+            std::size_t position() const { return _position; }
+
+            /// Read an unsigned integer.
+            std::uint64_t read_uint();
+
+            /// Read a floating-point number.
+            double read_double();
+
+            /// Read a string. The string remains valid as long as the image.
+            std::string_view read_string();
+
+            /// Read a YAML node and all its children.
+            YAML::Node read_node();
+
+            /// Skip a YAML node and all its children.
+            void skip_node();
+    };
+}
+
+#endif
@@ -0,0 +1,141 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2026 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <test/test.hh>
+#include <eos/utils/database-image.hh>
+
+#include <cstdlib>
+#include <fstream>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+#include <yaml-cpp/yaml.h>
+
+using namespace test;
+using namespace eos;
+
+namespace fs = boost::filesystem;
+
+class DatabaseImageTest :
+    public TestCase
+{
+    public:
+        DatabaseImageTest() :
+            TestCase("database_image_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            const fs::path directory = fs::temp_directory_path() / fs::unique_path("eos-database-image-%%%%-%%%%");
+            fs::create_directories(directory);
+            const std::string file = (directory / "test.eosdb").string();
+
+            // roundtrip of words, strings, and nodes
+            {
+                YAML::Node node = YAML::Load("{ type: Gaussian, observables: [ 'mass::c', 'mass::b(MSbar)' ], mean: 1.27, empty: ~ }");
+
+                DatabaseImageWriter writer;
+                writer.write_uint(0);
+                writer.write_uint(17);
+                writer.write_double(-1.25e-3);
+                writer.write_string("foo");
+                writer.write_string("bar");
+                writer.write_string("foo");
+                const std::size_t node_position = writer.position();
+                writer.write_node(node);
+                writer.write_uint(42);
+                writer.set_uint(0, node_position);
+                TEST_CHECK_THROWS(InternalError, writer.set_uint(writer.position(), 0));
+                writer.save(file, 0x1234);
+
+                auto image = DatabaseImage::open(file, 0x1234);
+                TEST_CHECK(nullptr != image);
+
+                auto cursor = image->cursor();
+                TEST_CHECK_EQUAL(cursor.read_uint(), node_position);
+                TEST_CHECK_EQUAL(cursor.read_uint(), 17u);
+                TEST_CHECK_EQUAL(cursor.read_double(), -1.25e-3);
+                TEST_CHECK_EQUAL(std::string(cursor.read_string()), "foo");
+                TEST_CHECK_EQUAL(std::string(cursor.read_string()), "bar");
+                TEST_CHECK_EQUAL(std::string(cursor.read_string()), "foo");
+                TEST_CHECK_EQUAL(cursor.position(), node_position);
+
+                YAML::Node result = cursor.read_node();
+                TEST_CHECK(result.IsMap());
+                TEST_CHECK_EQUAL(result.size(), 4u);
+                TEST_CHECK_EQUAL(result["type"].as<std::string>(), "Gaussian");
+                TEST_CHECK(result["observables"].IsSequence());
+                TEST_CHECK_EQUAL(result["observables"].size(), 2u);
+                TEST_CHECK_EQUAL(result["observables"][1].as<std::string>(), "mass::b(MSbar)");
+                TEST_CHECK_EQUAL(result["mean"].as<double>(), 1.27);
+                TEST_CHECK(result["empty"].IsNull());
+                TEST_CHECK_EQUAL(cursor.read_uint(), 42u);
+                TEST_CHECK_EQUAL(cursor.position(), image->size());
+
+                // skipping a node
+                auto other = image->cursor(node_position);
+                other.skip_node();
+                TEST_CHECK_EQUAL(other.read_uint(), 42u);
+
+                // reading beyond the end
+                TEST_CHECK_THROWS(InternalError, other.read_uint());
+            }
+
+            // images with other fingerprints, missing images, and ignored images
+            {
+                TEST_CHECK(nullptr == DatabaseImage::open(file, 0x1235));
+                TEST_CHECK(nullptr == DatabaseImage::open((directory / "missing.eosdb").string(), 0x1234));
+
+                ::setenv("EOS_IGNORE_DATABASE_IMAGES", "1", 1);
+                TEST_CHECK(nullptr == DatabaseImage::open(file, 0x1234));
+                ::unsetenv("EOS_IGNORE_DATABASE_IMAGES");
+                TEST_CHECK(nullptr != DatabaseImage::open(file, 0x1234));
+            }
+
+            // truncated images
+            {
+                fs::resize_file(file, fs::file_size(file) - 1);
+                TEST_CHECK(nullptr == DatabaseImage::open(file, 0x1234));
+            }
+
+            // fingerprints
+            {
+                std::ofstream((directory / "a.yaml").string()) << "foo: 1";
+                std::ofstream((directory / "b.txt").string())  << "bar";
+                const std::uint64_t original = DatabaseImage::fingerprint(directory.string(), ".yaml");
+                TEST_CHECK_EQUAL(DatabaseImage::fingerprint(directory.string(), ".yaml"), original);
+
+                // files with other extensions do not contribute
+                std::ofstream((directory / "b.txt").string())  << "baz";
+                TEST_CHECK_EQUAL(DatabaseImage::fingerprint(directory.string(), ".yaml"), original);
+
+                // changes of the contents
+                std::ofstream((directory / "a.yaml").string()) << "foo: 2";
+                const std::uint64_t changed = DatabaseImage::fingerprint(directory.string(), ".yaml");
+                TEST_CHECK(changed != original);
+
+                // additional files
+                std::ofstream((directory / "c.yaml").string()) << "";
+                TEST_CHECK(changed != DatabaseImage::fingerprint(directory.string(), ".yaml"));
+            }
+
+            fs::remove_all(directory);
+        }
+} database_image_test;
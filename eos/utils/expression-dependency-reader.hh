@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2021 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_EOS_UTILS_EXPRESSION_DEPENDENCY_READER_HH
+#define EOS_GUARD_EOS_UTILS_EXPRESSION_DEPENDENCY_READER_HH 1
+
+#include <eos/utils/expression-fwd.hh>
+#include <eos/utils/observable_cache.hh>
+
+#include <set>
+
+namespace eos::exp
+{
+    // Visit the expression tree and collect the ids of all cached observables
+    // whose predictions the expression relies upon.
+    class ExpressionDependencyReader
+    {
+        public:
+            std::set<ObservableCache::Id> ids;
+
+            ExpressionDependencyReader() = default;
+            ~ExpressionDependencyReader() = default;
+
+            void visit(const BinaryExpression & e);
+
+            void visit(const ConstantExpression &);
+
+            void visit(const ObservableNameExpression &);
+
+            void visit(const ObservableExpression &);
+
+            void visit(const KinematicVariableNameExpression &);
+
+            void visit(const KinematicVariableExpression &);
+
+            void visit(const CachedObservableExpression & e);
+    };
+}
+
+#endif
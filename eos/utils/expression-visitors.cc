@@ -21,6 +21,7 @@
 #include <eos/utils/expression.hh>
 #include <eos/utils/expression-cacher.hh>
 #include <eos/utils/expression-cloner.hh>
+#include <eos/utils/expression-dependency-reader.hh>
 #include <eos/utils/expression-evaluator.hh>
 #include <eos/utils/expression-kinematic-reader.hh>
 #include <eos/utils/expression-maker.hh>
@@ -439,13 +440,9 @@ namespace eos::exp
         std::set<std::string> kinematic_set;
         std::set<std::string> alias_set;
 
-        const auto & entries = impl::observable_entries;
-        const auto & it = entries.find(e.observable_name);
-
         // check if 'e' matches the name of a known observable
-        if (it != entries.end())
+        if (const auto entry = ObservableEntries::instance()->find(e.observable_name))
         {
-            const auto entry = it->second;
 
             kinematic_set.insert(entry->begin_kinematic_variables(), entry->end_kinematic_variables());
 
@@ -609,4 +606,45 @@ namespace eos::exp
 
         return e;
     }
+
+    /*
+     * ExpressionDependencyReader
+     */
+    void
+    ExpressionDependencyReader::visit(const BinaryExpression & e)
+    {
+        e.lhs.accept(*this);
+        e.rhs.accept(*this);
+    }
+
+    void
+    ExpressionDependencyReader::visit(const ConstantExpression &)
+    {
+    }
+
+    void
+    ExpressionDependencyReader::visit(const ObservableNameExpression &)
+    {
+    }
+
+    void
+    ExpressionDependencyReader::visit(const ObservableExpression &)
+    {
+    }
+
+    void
+    ExpressionDependencyReader::visit(const KinematicVariableNameExpression &)
+    {
+    }
+
+    void
+    ExpressionDependencyReader::visit(const KinematicVariableExpression &)
+    {
+    }
+
+    void
+    ExpressionDependencyReader::visit(const CachedObservableExpression & e)
+    {
+        this->ids.insert(e.id);
+    }
 }
@@ -16,12 +16,58 @@
  * Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
+#include <eos/utils/destringify.hh>
 #include <eos/utils/memoise.hh>
+#include <eos/utils/stringify.hh>
+
+#include <algorithm>
+#include <cstdlib>
+
+#include <cxxabi.h>
+#include <dlfcn.h>
 
 namespace eos
 {
+    namespace implementation
+    {
+        unsigned default_memoisation_capacity()
+        {
+            unsigned result = 100000u;
+
+            const char * env_capacity = std::getenv("EOS_MEMOISATION_CAPACITY");
+            if (env_capacity)
+            {
+                result = destringify<unsigned>(env_capacity);
+            }
+
+            return result;
+        }
+
+        std::string function_name(const void * function)
+        {
+            Dl_info info;
+            if ((0 == dladdr(function, &info)) || (nullptr == info.dli_sname))
+            {
+                return "<function at " + stringify(function) + ">";
+            }
+
+            int status = 0;
+            char * demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+            if ((0 != status) || (nullptr == demangled))
+            {
+                return info.dli_sname;
+            }
+
+            std::string result(demangled);
+            std::free(demangled);
+
+            return result;
+        }
+    }
+
     MemoisationControl::MemoisationControl() :
-        _mutex(new Mutex)
+        _mutex(new Mutex),
+        _capacity(implementation::default_memoisation_capacity())
     {
     }
 
@@ -38,6 +84,14 @@ namespace eos
         _clear_functions.push_back(clear_function);
     }
 
+    void
+    MemoisationControl::register_resize_function(const std::function<void (const unsigned &)> & resize_function)
+    {
+        Lock l(*_mutex);
+
+        _resize_functions.push_back(resize_function);
+    }
+
     void
     MemoisationControl::clear()
     {
@@ -48,4 +102,50 @@ namespace eos
             _clear_function();
         }
     }
+
+    void
+    MemoisationControl::register_statistics_function(const std::function<void (std::vector<MemoisationStatistics> &)> & statistics_function)
+    {
+        Lock l(*_mutex);
+
+        _statistics_functions.push_back(statistics_function);
+    }
+
+    unsigned
+    MemoisationControl::capacity() const
+    {
+        Lock l(*_mutex);
+
+        return _capacity;
+    }
+
+    void
+    MemoisationControl::set_capacity(const unsigned & capacity)
+    {
+        Lock l(*_mutex);
+
+        _capacity = capacity;
+
+        for (auto & _resize_function : _resize_functions)
+        {
+            _resize_function(capacity);
+        }
+    }
+
+    std::vector<MemoisationStatistics>
+    MemoisationControl::statistics() const
+    {
+        Lock l(*_mutex);
+
+        std::vector<MemoisationStatistics> result;
+        for (auto & _statistics_function : _statistics_functions)
+        {
+            _statistics_function(result);
+        }
+
+        std::sort(result.begin(), result.end(),
+                [] (const MemoisationStatistics & a, const MemoisationStatistics & b) { return a.function < b.function; });
+
+        return result;
+    }
 }
@@ -26,57 +26,19 @@
 #include <eos/utils/lock.hh>
 #include <eos/utils/mutex.hh>
 
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <cstdint>
+#include <cstring>
 #include <functional>
+#include <string>
 #include <tuple>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
-/* We are using a custom std::hash for tuple<FunctionPtr, double, ..., double> */
-namespace std
-{
-    template <typename U_> static uint64_t __hash_one(const U_ & u)
-    {
-        static_assert(sizeof(U_) == sizeof(uint32_t) || sizeof(U_) == sizeof(uint64_t), "Need to specialize __hash_one for non 32- and 64-bit data types");
-
-        if (sizeof(U_) == sizeof(int64_t))
-        {
-            return *reinterpret_cast<const uint64_t *>(&u);
-        }
-        else if (sizeof(U_) == sizeof(int32_t))
-        {
-            return static_cast<uint64_t>(*reinterpret_cast<const uint32_t *>(&u));
-        }
-    }
-
-    template <unsigned n_, typename ... T_>
-    struct __TupleHasher
-    {
-        static uint64_t hash(const std::tuple<T_ ...> & t)
-        {
-            return __TupleHasher<n_ - 1, T_ ...>::hash(t) ^ __hash_one<decltype(std::get<n_>(t))>(std::get<n_>(t));
-        }
-    };
-
-    template <typename ... T_>
-    struct __TupleHasher<0, T_ ...>
-    {
-        static uint64_t hash(const std::tuple<T_ ...> & t)
-        {
-            return __hash_one<decltype(std::get<0>(t))>(std::get<0>(t));
-        }
-    };
-
-    template <typename ... T_>
-    struct hash<std::tuple<T_ ...>>
-    {
-        size_t operator() (const std::tuple<T_ ...> & t) const
-        {
-            return __TupleHasher<sizeof...(T_) - 1, T_ ...>::hash(t);
-        }
-    };
-}
-
 namespace eos
 {
     namespace implementation
@@ -94,8 +56,81 @@ namespace eos
         {
             using Type = Result_;
         };
+
+        // Finalisation step of the SplitMix64 generator, which mixes all input bits into all output bits
+        inline uint64_t mix_bits(uint64_t x)
+        {
+            x ^= x >> 30;
+            x *= 0xbf58476d1ce4e5b9ull;
+            x ^= x >> 27;
+            x *= 0x94d049bb133111ebull;
+            x ^= x >> 31;
+
+            return x;
+        }
+
+        template <typename T_> uint64_t hash_one(const T_ & t)
+        {
+            if constexpr (std::is_floating_point<T_>::value)
+            {
+                // +0.0 and -0.0 compare equal, and must therefore yield the same hash
+                const T_ value = (t == T_(0)) ? T_(0) : t;
+                uint64_t result = 0;
+                std::memcpy(&result, &value, std::min(sizeof(T_), sizeof(uint64_t)));
+
+                return result;
+            }
+            else if constexpr (std::is_pointer<T_>::value)
+            {
+                return static_cast<uint64_t>(reinterpret_cast<std::uintptr_t>(t));
+            }
+            else
+            {
+                return static_cast<uint64_t>(std::hash<T_>()(t));
+            }
+        }
+
+        // Retrieve a human-readable name of a function from its address
+        std::string function_name(const void * function);
+
+        // Order-dependent hash of the memoisation keys, such that (f, a, b) and (f, b, a) do not collide
+        struct MemoisationKeyHash
+        {
+            template <typename ... T_>
+            std::size_t operator() (const std::tuple<T_ ...> & key) const
+            {
+                uint64_t result = 0x9e3779b97f4a7c15ull;
+                std::apply([&result] (const T_ & ... t) { ((result = mix_bits(result ^ (hash_one(t) + 0x9e3779b97f4a7c15ull + (result << 6) + (result >> 2)))), ...); }, key);
+
+                return static_cast<std::size_t>(result);
+            }
+        };
     }
 
+    /*!
+     * MemoisationStatistics holds the counters of all memoisations of one function.
+     */
+    struct MemoisationStatistics
+    {
+        /// The name of the memoised function.
+        std::string function;
+
+        /// The number of calls that were answered from a memoisation.
+        unsigned long hits = 0;
+
+        /// The number of calls that required an evaluation of the function.
+        unsigned long misses = 0;
+
+        /// The number of memoisations that were evicted to make space for new ones.
+        unsigned long evictions = 0;
+
+        /// The number of memoisations that are currently held.
+        unsigned long entries = 0;
+
+        /// The total time spent evaluating the function, in seconds.
+        double time = 0.0;
+    };
+
     class MemoisationControl :
         public InstantiationPolicy<MemoisationControl, Singleton>
     {
@@ -104,6 +139,12 @@ namespace eos
 
             std::vector<std::function<void ()>> _clear_functions;
 
+            std::vector<std::function<void (const unsigned &)>> _resize_functions;
+
+            std::vector<std::function<void (std::vector<MemoisationStatistics> &)>> _statistics_functions;
+
+            unsigned _capacity;
+
         public:
             MemoisationControl();
 
@@ -111,9 +152,45 @@ namespace eos
 
             void register_clear_function(const std::function<void ()> & clear_function);
 
+            void register_resize_function(const std::function<void (const unsigned &)> & resize_function);
+
+            void register_statistics_function(const std::function<void (std::vector<MemoisationStatistics> &)> & statistics_function);
+
+            /// Clear all memoisations of all memoisers.
             void clear();
+
+            /*!
+             * Retrieve the maximal number of memoisations per memoiser.
+             *
+             * Defaults to 100000, unless overridden by the environment variable EOS_MEMOISATION_CAPACITY.
+             */
+            unsigned capacity() const;
+
+            /*!
+             * Set the maximal number of memoisations per memoiser.
+             *
+             * All existing memoisations are cleared.
+             *
+             * @param capacity The new maximal number of memoisations per memoiser.
+             */
+            void set_capacity(const unsigned & capacity);
+
+            /*!
+             * Retrieve the counters of all memoised functions.
+             *
+             * The result contains one entry per memoised function, ordered by the function's name.
+             */
+            std::vector<MemoisationStatistics> statistics() const;
     };
 
+    /*!
+     * Memoiser keeps the results of previous calls to functions with a common signature.
+     *
+     * The memoisations are distributed across a fixed number of shards, each with its own
+     * lock, to reduce contention between threads. Each shard holds a bounded number of
+     * memoisations. Once a shard is full, the CLOCK algorithm evicts a memoisation that has
+     * not been used recently.
+     */
     template <typename Result_, typename ... Params_>
     class Memoiser :
         public InstantiationPolicy<Memoiser<Result_, Params_ ...>, Singleton>
@@ -122,57 +199,219 @@ namespace eos
             using FunctionType = Result_(*)(const Params_ & ...);
             using KeyType = std::tuple<FunctionType, Params_...>;
 
+            static constexpr unsigned number_of_shards = 16;
+
         private:
-            Mutex * const _mutex;
+            struct Entry
+            {
+                Result_ result;
+
+                bool referenced;
+            };
+
+            struct Counters
+            {
+                unsigned long hits = 0;
+
+                unsigned long misses = 0;
+
+                unsigned long evictions = 0;
+
+                unsigned long entries = 0;
+
+                std::chrono::steady_clock::duration time = std::chrono::steady_clock::duration::zero();
+            };
+
+            struct Shard
+            {
+                Mutex mutex;
 
-            std::unordered_map<KeyType, Result_> _memoisations;
+                std::unordered_map<KeyType, Entry, implementation::MemoisationKeyHash> memoisations;
+
+                // The memoisations in the order of the CLOCK algorithm; the entries are stable across rehashing
+                std::vector<std::pair<KeyType, Entry *>> clock;
+
+                std::size_t hand = 0;
+
+                std::size_t capacity = 1;
+
+                // The counters of each memoised function
+                std::unordered_map<FunctionType, Counters> counters;
+
+                void insert(const KeyType & key, const Result_ & result)
+                {
+                    auto i = memoisations.insert(std::make_pair(key, Entry{ result, false }));
+                    if (! i.second)
+                        return;
+
+                    Entry * entry = &i.first->second;
+                    counters[std::get<0>(key)].entries += 1;
+
+                    if (clock.size() < capacity)
+                    {
+                        clock.push_back(std::make_pair(key, entry));
+                        return;
+                    }
+
+                    // evict the first memoisation that has not been referenced since the hand last passed it
+                    while (true)
+                    {
+                        auto & slot = clock[hand];
+                        hand = (hand + 1) % clock.size();
+
+                        if (slot.second->referenced)
+                        {
+                            slot.second->referenced = false;
+                            continue;
+                        }
+
+                        auto & evicted = counters[std::get<0>(slot.first)];
+                        evicted.evictions += 1;
+                        evicted.entries -= 1;
+
+                        memoisations.erase(slot.first);
+                        slot = std::make_pair(key, entry);
+                        break;
+                    }
+                }
+
+                void clear()
+                {
+                    memoisations.clear();
+                    clock.clear();
+                    hand = 0;
+
+                    for (auto & c : counters)
+                    {
+                        c.second.entries = 0;
+                    }
+                }
+            };
+
+            mutable std::array<Shard, number_of_shards> _shards;
+
+            Shard & _shard(const KeyType & key) const
+            {
+                return _shards[implementation::MemoisationKeyHash()(key) % number_of_shards];
+            }
+
+            void _resize(const unsigned & capacity)
+            {
+                const std::size_t shard_capacity = std::max<std::size_t>(1, capacity / number_of_shards);
+
+                for (auto & shard : _shards)
+                {
+                    Lock l(shard.mutex);
+
+                    shard.clear();
+                    shard.capacity = shard_capacity;
+                }
+            }
 
         public:
-            Memoiser() :
-                _mutex(new Mutex)
+            Memoiser()
             {
                 MemoisationControl::instance()->register_clear_function(std::bind(&Memoiser<Result_, Params_ ...>::clear, this));
+                MemoisationControl::instance()->register_resize_function(std::bind(&Memoiser<Result_, Params_ ...>::_resize, this, std::placeholders::_1));
+                MemoisationControl::instance()->register_statistics_function(std::bind(&Memoiser<Result_, Params_ ...>::statistics, this, std::placeholders::_1));
+
+                _resize(MemoisationControl::instance()->capacity());
             }
 
             ~Memoiser()
             {
-                delete _mutex;
             }
 
             Result_ operator() (const FunctionType & f, const Params_ & ... p)
             {
-                Lock l(*_mutex);
-
                 KeyType key(f, p ...);
-                auto i = _memoisations.find(key);
+                Shard & shard = _shard(key);
 
-                if (_memoisations.end() != i)
-                    return i->second;
+                {
+                    Lock l(shard.mutex);
 
-                Result_ result = f(p ...);
+                    auto i = shard.memoisations.find(key);
+                    if (shard.memoisations.end() != i)
+                    {
+                        i->second.referenced = true;
+                        shard.counters[f].hits += 1;
 
-                if (_memoisations.size() > 100000u)
-                {
-                    _memoisations.clear();
+                        return i->second.result;
+                    }
                 }
 
-                _memoisations.insert(std::pair<KeyType, Result_>(key, result));
+                // evaluate the function without holding the lock, so that other threads can use this shard
+                const auto start = std::chrono::steady_clock::now();
+                Result_ result = f(p ...);
+                const auto time = std::chrono::steady_clock::now() - start;
+
+                Lock l(shard.mutex);
+                auto & counters = shard.counters[f];
+                counters.misses += 1;
+                counters.time += time;
+                shard.insert(key, result);
 
                 return result;
             }
 
             void clear()
             {
-                Lock l(*_mutex);
+                for (auto & shard : _shards)
+                {
+                    Lock l(shard.mutex);
+
+                    shard.clear();
+                }
+            }
+
+            /*!
+             * Append the counters of each function memoised by this Memoiser.
+             *
+             * @param result The list of statistics to which our counters are appended.
+             */
+            void statistics(std::vector<MemoisationStatistics> & result) const
+            {
+                std::unordered_map<FunctionType, Counters> totals;
+                for (auto & shard : _shards)
+                {
+                    Lock l(shard.mutex);
+
+                    for (const auto & c : shard.counters)
+                    {
+                        auto & total = totals[c.first];
+                        total.hits      += c.second.hits;
+                        total.misses    += c.second.misses;
+                        total.evictions += c.second.evictions;
+                        total.entries   += c.second.entries;
+                        total.time      += c.second.time;
+                    }
+                }
 
-                _memoisations.clear();
+                for (const auto & t : totals)
+                {
+                    MemoisationStatistics s;
+                    s.function  = implementation::function_name(reinterpret_cast<const void *>(t.first));
+                    s.hits      = t.second.hits;
+                    s.misses    = t.second.misses;
+                    s.evictions = t.second.evictions;
+                    s.entries   = t.second.entries;
+                    s.time      = std::chrono::duration<double>(t.second.time).count();
+
+                    result.push_back(s);
+                }
             }
 
             unsigned number_of_memoisations() const
             {
-                Lock l(*_mutex);
+                unsigned result = 0;
+                for (auto & shard : _shards)
+                {
+                    Lock l(shard.mutex);
 
-                return _memoisations.size();
+                    result += shard.memoisations.size();
+                }
+
+                return result;
             }
     };
 
@@ -21,6 +21,7 @@
 #include <eos/utils/memoise.hh>
 
 #include <complex>
+#include <string>
 
 using namespace test;
 using namespace eos;
@@ -92,6 +93,21 @@ class MemoiseTest :
                 TEST_CHECK_EQUAL(2, number_of_memoisations(f2, 0.0, 0.0));
             }
 
+            /* Test that the order of the arguments matters */
+            {
+                TEST_CHECK_EQUAL(0.25, memoise(f1, 1.0, 4.0));
+                TEST_CHECK_EQUAL(4.0,  memoise(f1, 4.0, 1.0));
+                TEST_CHECK_EQUAL(0.25, memoise(f1, 1.0, 4.0));
+                TEST_CHECK_EQUAL(4, number_of_memoisations(f1, 0.0, 0.0));
+
+                // restore the previous memoisations
+                MemoisationControl::instance()->clear();
+                TEST_CHECK_EQUAL(0.5, memoise(f1, 1.0, 2.0));
+                TEST_CHECK_EQUAL(2.0, memoise(f1, 2.0, 1.0));
+                TEST_CHECK_EQUAL(1.0, real(memoise(f2, 1.0, 2.0)));
+                TEST_CHECK_EQUAL(2.0, real(memoise(f2, 2.0, 1.0)));
+            }
+
             /* Test clearing all memoisations */
             {
                 // There should be 2 memoisations per function
@@ -104,5 +120,60 @@ class MemoiseTest :
                 TEST_CHECK_EQUAL(0, number_of_memoisations(f1, 0.0, 0.0));
                 TEST_CHECK_EQUAL(0, number_of_memoisations(f2, 0.0, 0.0));
             }
+
+            /* Test bounded capacity */
+            {
+                const unsigned capacity = MemoisationControl::instance()->capacity();
+                MemoisationControl::instance()->set_capacity(64);
+
+                for (unsigned i = 1 ; i <= 1000 ; ++i)
+                {
+                    TEST_CHECK_EQUAL(double(i) / 2.0, memoise(f1, double(i), 2.0));
+                }
+                TEST_CHECK(number_of_memoisations(f1, 0.0, 0.0) <= 64);
+                TEST_CHECK(number_of_memoisations(f1, 0.0, 0.0) > 0);
+
+                // recently used memoisations survive the eviction
+                for (unsigned i = 1 ; i <= 1000 ; ++i)
+                {
+                    TEST_CHECK_EQUAL(0.5, memoise(f1, 1.0, 2.0));
+                    TEST_CHECK_EQUAL(double(i) / 4.0, memoise(f1, double(i), 4.0));
+                }
+                TEST_CHECK(number_of_memoisations(f1, 0.0, 0.0) <= 64);
+
+                MemoisationControl::instance()->set_capacity(capacity);
+                TEST_CHECK_EQUAL(0, number_of_memoisations(f1, 0.0, 0.0));
+            }
+
+            /* Test statistics */
+            {
+                const std::string name = implementation::function_name(reinterpret_cast<const void *>(&f1));
+                auto find = [&name] ()
+                {
+                    for (const auto & s : MemoisationControl::instance()->statistics())
+                    {
+                        if (s.function == name)
+                            return s;
+                    }
+
+                    return MemoisationStatistics();
+                };
+
+                const auto before = find();
+                TEST_CHECK_EQUAL(name, before.function);
+                TEST_CHECK(before.evictions > 0);
+                TEST_CHECK_EQUAL(before.entries, 0);
+
+                TEST_CHECK_EQUAL(0.6, memoise(f1, 3.0, 5.0));
+                TEST_CHECK_EQUAL(0.6, memoise(f1, 3.0, 5.0));
+                TEST_CHECK_EQUAL(5.0 / 3.0, memoise(f1, 5.0, 3.0));
+
+                const auto after = find();
+                TEST_CHECK_EQUAL(after.misses - before.misses, 2);
+                TEST_CHECK_EQUAL(after.hits - before.hits, 1);
+                TEST_CHECK_EQUAL(after.evictions, before.evictions);
+                TEST_CHECK_EQUAL(after.entries, 2);
+                TEST_CHECK(after.time >= before.time);
+            }
         }
 } memoise_test;
@@ -19,19 +19,25 @@
  */
 
 #include <eos/utils/expression-cacher.hh>
+#include <eos/utils/expression-dependency-reader.hh>
 #include <eos/utils/expression-observable.hh>
 #include <eos/utils/log.hh>
 #include <eos/utils/observable_cache.hh>
 #include <eos/utils/observable_set.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
 #include <eos/utils/thread_pool.hh>
+#include <eos/utils/wilson-polynomial.hh>
 #include <eos/utils/wrapped_forward_iterator-impl.hh>
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <limits>
 #include <map>
+#include <string>
 #include <tuple>
 #include <typeindex>
+#include <unordered_map>
 #include <vector>
 
 namespace eos
@@ -52,23 +58,80 @@ namespace eos
         // Contains each observable that needs to be calculated exactly once
         std::vector<ObservablePtr> observables;
 
-        // Contains each regular observable and its associated index
-        std::vector<std::tuple<ObservablePtr, ObservableCache::Id>> regular_observables;
+        // Maps the canonical key of each observable onto its index
+        std::unordered_multimap<std::string, ObservableCache::Id> observable_indices;
 
-        // Contains each cacheable observable and its associated index
-        std::multimap<std::type_index, std::tuple<CacheableObservable *, ObservableCache::Id>> cacheable_observables;
+        // Contains each cacheable observable and its associated index, indexed by the canonical key of its type, kinematics and options
+        std::unordered_multimap<std::string, std::tuple<CacheableObservable *, ObservableCache::Id>> cacheable_observables;
 
-        // Contains each cached observable and its associated index
-        std::vector<std::tuple<ObservablePtr, ObservableCache::Id>> cached_observables;
+        // The kinds of observables that are distinguished by the cache
+        enum class Kind
+        {
+            regular,
+            cacheable,
+            cached,
+            expression
+        };
+
+        // Contains the kind of each observable
+        std::vector<Kind> kinds;
+
+        // Contains, for each observable, the indices of the observables whose predictions or intermediate results it relies upon
+        //
+        // Producers are always added to the cache before their consumers. The order of the observables
+        // is therefore a topological order of the dependency graph.
+        std::vector<std::vector<ObservableCache::Id>> producers;
 
-        // Contains each expression observable and its associated index
-        std::vector<std::tuple<ObservablePtr, ObservableCache::Id>> expression_observables;
+        // Contains, for each observable, the indices of the observables that rely upon its prediction or intermediate result
+        std::vector<std::vector<ObservableCache::Id>> consumers;
 
         // Contains values of all observables
         std::vector<double> predictions;
 
+        // Contains each parameter used by any of the observables, its value as of the last update, and the indices of its users
+        struct Dependency
+        {
+            Parameter parameter;
+
+            double value;
+
+            std::vector<ObservableCache::Id> users;
+        };
+        std::vector<Dependency> dependencies;
+
+        // Maps a parameter id onto its entry in the dependencies
+        std::map<Parameter::Id, unsigned> dependency_indices;
+
+        // Contains the values of each observable's kinematic variables as of the last update
+        std::vector<std::vector<double>> kinematics_values;
+
+        // Flags each observable that needs to be re-evaluated in the next update
+        std::vector<char> outdated;
+
+        // The generation of the parameters as of the last update
+        unsigned long generation;
+
+        // Whether the evaluations are profiled
+        bool profiling;
+
+        // Contains the profiling information of each observable
+        //
+        // Each observable is evaluated by at most one task per update, and its entry
+        // can therefore be modified without synchronization.
+        struct Timing
+        {
+            unsigned long calls = 0;
+
+            unsigned long exceptions = 0;
+
+            std::chrono::steady_clock::duration time = std::chrono::steady_clock::duration::zero();
+        };
+        std::vector<Timing> timings;
+
         Implementation(const Parameters & parameters) :
-            parameters(parameters)
+            parameters(parameters),
+            generation(parameters.generation()),
+            profiling(false)
         {
         }
 
@@ -99,19 +162,283 @@ namespace eos
             return true;
         }
 
+        // Create a canonical key from an identifier and the observable's kinematics and options
+        //
+        // Identical observables always yield identical keys. Since the kinematics can change after an observable
+        // has been added, candidates found through the key must still be compared with identical_observables().
+        static std::string canonical_key(const std::string & identifier, Observable & observable)
+        {
+            return identifier + '|' + observable.options().as_string() + '|' + observable.kinematics().as_string();
+        }
+
+        // Register a newly added observable in the reverse index from parameter ids to observables, and in the dependency graph
+        void register_observable(const ObservablePtr & observable, const ObservableCache::Id & index, const Kind & kind,
+                const std::vector<ObservableCache::Id> & observable_producers = {})
+        {
+            for (const auto & id : *observable)
+            {
+                auto i = dependency_indices.find(id);
+                if (dependency_indices.end() == i)
+                {
+                    i = dependency_indices.insert(std::make_pair(id, dependencies.size())).first;
+                    Parameter parameter = parameters[id];
+                    dependencies.push_back(Dependency{ parameter, parameter.evaluate(), {} });
+                }
+
+                dependencies[i->second].users.push_back(index);
+            }
+
+            for (const auto & p : observable_producers)
+            {
+                consumers[p].push_back(index);
+            }
+
+            observable_indices.insert(std::make_pair(canonical_key(observable->name().str(), *observable), index));
+
+            kinds.push_back(kind);
+            producers.push_back(observable_producers);
+            consumers.push_back({});
+
+            predictions.push_back(std::numeric_limits<double>::quiet_NaN());
+            kinematics_values.push_back({});
+            outdated.push_back(true);
+            timings.push_back(Timing());
+        }
+
+        // Flag all observables that are affected by changes of the parameters or their kinematics since the last update
+        void mark_outdated()
+        {
+            // only inspect the dependencies if any parameter has been set since the last update
+            if (parameters.generation() != generation)
+            {
+                for (auto & d : dependencies)
+                {
+                    if (d.parameter.generation() <= generation)
+                        continue;
+
+                    // a parameter might have been set to its previous value
+                    // NaN values never compare equal, and are therefore always considered changed
+                    const double value = d.parameter.evaluate();
+                    if (value == d.value)
+                        continue;
+
+                    d.value = value;
+                    for (const auto & idx : d.users)
+                    {
+                        outdated[idx] = true;
+                    }
+                }
+
+                generation = parameters.generation();
+            }
+
+            for (ObservableCache::Id idx = 0 ; idx < observables.size() ; ++idx)
+            {
+                auto & o = observables[idx];
+
+                // we cannot track observables that do not declare their parameters
+                // expressions only rely on their producers and their kinematics, which are both tracked
+                if ((Kind::expression != kinds[idx]) && (o->begin() == o->end()))
+                {
+                    outdated[idx] = true;
+                }
+
+                // observables must follow the observables whose predictions or intermediate results they rely upon
+                // the producers precede the observable, and their flags are therefore final at this point
+                for (const auto & p : producers[idx])
+                {
+                    if (outdated[p])
+                    {
+                        outdated[idx] = true;
+                    }
+                }
+
+                auto & values = kinematics_values[idx];
+                unsigned k = 0;
+                bool changed = false;
+                for (const auto & v : o->kinematics())
+                {
+                    const double value = v.evaluate();
+                    if (k < values.size())
+                    {
+                        changed |= (values[k] != value);
+                        values[k] = value;
+                    }
+                    else
+                    {
+                        changed = true;
+                        values.push_back(value);
+                    }
+                    ++k;
+                }
+
+                if (changed)
+                {
+                    outdated[idx] = true;
+                }
+            }
+        }
+
+        // Describe an observable by its name, kinematics and options
+        std::string describe(const ObservableCache::Id & idx) const
+        {
+            const auto & o = observables[idx];
+
+            return o->name().str() + "[" + o->kinematics().as_string() + "];" + o->options().as_string();
+        }
+
+        // Evaluate a single observable and store its prediction; returns false if an exception was encountered
+        bool compute(const ObservableCache::Id & idx)
+        {
+            static const char * kind_names[] = { "regular", "cacheable", "cached", "expression" };
+
+            try
+            {
+                predictions[idx] = observables[idx]->evaluate();
+            }
+            catch (eos::Exception & e)
+            {
+                Log::instance()->message("ObservableCache::update", ll_error)
+                    << "Exception encountered when evaluating " << kind_names[static_cast<int>(kinds[idx])] << " observable '" << describe(idx) << "': "
+                    << e.what();
+                predictions[idx] = std::numeric_limits<double>::quiet_NaN();
+
+                return false;
+            }
+
+            return true;
+        }
+
+        // Evaluate a single observable, and record its profiling information if requested
+        void evaluate(const ObservableCache::Id & idx)
+        {
+            if (! profiling)
+            {
+                compute(idx);
+                return;
+            }
+
+            const auto start = std::chrono::steady_clock::now();
+            const bool success = compute(idx);
+
+            auto & t = timings[idx];
+            t.time += std::chrono::steady_clock::now() - start;
+            t.calls += 1;
+            if (! success)
+                t.exceptions += 1;
+        }
+
+        // Evaluate an outdated observable, and then each of its outdated consumers that becomes ready
+        //
+        // The first ready consumer is evaluated by the same task, while further ready consumers are
+        // run as new tasks of the group.
+        void evaluate_node(TaskGroup & tasks, std::vector<std::atomic<unsigned>> & awaited, ObservableCache::Id idx)
+        {
+            while (true)
+            {
+                evaluate(idx);
+
+                bool has_next = false;
+                ObservableCache::Id next = 0;
+                for (const auto & c : consumers[idx])
+                {
+                    if (! outdated[c])
+                        continue;
+
+                    // is this the last outdated producer that the consumer awaits?
+                    if (1 != awaited[c]--)
+                        continue;
+
+                    if (! has_next)
+                    {
+                        has_next = true;
+                        next = c;
+                        continue;
+                    }
+
+                    tasks.run([this, &tasks, &awaited, c]() {
+                        evaluate_node(tasks, awaited, c);
+                    });
+                }
+
+                if (! has_next)
+                    break;
+
+                idx = next;
+            }
+        }
+
+        // Update all outdated observables in parallel, following the dependency graph
+        void update_parallel()
+        {
+            mark_outdated();
+
+            // count the outdated producers that each outdated observable awaits
+            std::vector<std::atomic<unsigned>> awaited(observables.size());
+            std::vector<ObservableCache::Id> ready;
+            for (ObservableCache::Id idx = 0 ; idx < observables.size() ; ++idx)
+            {
+                if (! outdated[idx])
+                    continue;
+
+                unsigned n = 0;
+                for (const auto & p : producers[idx])
+                {
+                    if (outdated[p])
+                        ++n;
+                }
+
+                awaited[idx] = n;
+                if (0 == n)
+                {
+                    ready.push_back(idx);
+                }
+            }
+
+            // each observable is evaluated as soon as all of its producers have been evaluated
+            TaskGroup tasks;
+            for (const auto & idx : ready)
+            {
+                tasks.run([this, &tasks, &awaited, idx]() {
+                    evaluate_node(tasks, awaited, idx);
+                });
+            }
+            tasks.wait();
+
+            std::fill(outdated.begin(), outdated.end(), false);
+        }
+
+        // Update all outdated observables on the calling thread
+        void update_serial()
+        {
+            mark_outdated();
+
+            // the order of the observables respects all dependencies
+            for (ObservableCache::Id idx = 0 ; idx < observables.size() ; ++idx)
+            {
+                if (! outdated[idx])
+                    continue;
+
+                outdated[idx] = false;
+                evaluate(idx);
+            }
+        }
+
         ObservableCache::Id add(const ObservablePtr & observable, const ObservableCache & cache)
         {
             if (observable->parameters() != parameters)
                 throw InternalError("ObservableCache::add(): Mismatch of Parameters between different observables detected.");
 
-            // compare each observable for options, kinematics and name
-            unsigned index = 0;
-            for (auto i = observables.begin(), i_end = observables.end() ; i != i_end ; ++i, ++index)
+            // compare each observable with the same canonical key for options, kinematics and name
+            auto range = observable_indices.equal_range(canonical_key(observable->name().str(), *observable));
+            for (auto i = range.first ; i != range.second ; ++i)
             {
-                if (identical_observables(*i, observable))
-                    return index;
+                if (identical_observables(observables[i->second], observable))
+                    return i->second;
             }
 
+            unsigned index = observables.size();
+
             CacheableObservable * cacheable_observable = dynamic_cast<CacheableObservable *>(observable.get());
             ExpressionObservable * expression_observable = dynamic_cast<ExpressionObservable *>(observable.get());
 
@@ -126,21 +453,29 @@ namespace eos
                 // ensure that the new index is correct, since the ExpressionCacher is capable to modify our cache
                 index = observables.size();
 
+                // the expression relies on the predictions of all observables that the ExpressionCacher added
+                exp::ExpressionDependencyReader dependency_reader;
+                static_cast<ExpressionObservable *>(cached_expression_observable.get())->expression().accept(dependency_reader);
+
                 observables.push_back(cached_expression_observable);
-                predictions.push_back(std::numeric_limits<double>::quiet_NaN());
-                expression_observables.push_back(std::make_tuple(cached_expression_observable, index));
+                register_observable(cached_expression_observable, index, Kind::expression,
+                        std::vector<ObservableCache::Id>(dependency_reader.ids.cbegin(), dependency_reader.ids.cend()));
 
                 return index;
             }
             else if (nullptr != cacheable_observable) // is the new observable cacheable?
             {
                 std::type_index type_index(typeid(*cacheable_observable));
+                const std::string key = canonical_key(type_index.name(), *cacheable_observable);
 
-                // have we encountered this type of cacheable observable before?
-                auto range = cacheable_observables.equal_range(type_index);
+                // have we encountered this type of cacheable observable with the same kinematics and options before?
+                auto range = cacheable_observables.equal_range(key);
                 for (auto c = range.first, c_end = range.second ; c != c_end ; ++c)
                 {
                     // have we encountered this cacheable observable with the same properties before?
+                    if (std::type_index(typeid(*std::get<0>(c->second))) != type_index)
+                        continue;
+
                     if (std::get<0>(c->second)->kinematics() != cacheable_observable->kinematics())
                         continue;
 
@@ -154,16 +489,15 @@ namespace eos
 
                     // add the newly created cached observable
                     observables.push_back(cached_observable);
-                    predictions.push_back(std::numeric_limits<double>::quiet_NaN());
-                    cached_observables.push_back(std::make_tuple(cached_observable, index));
+                    register_observable(cached_observable, index, Kind::cached, { std::get<1>(c->second) });
 
                     return index;
                 }
 
                 // else add this new cacheable observable
                 observables.push_back(observable);
-                predictions.push_back(std::numeric_limits<double>::quiet_NaN());
-                cacheable_observables.insert(std::make_pair(type_index, std::make_tuple(cacheable_observable, index)));
+                register_observable(observable, index, Kind::cacheable);
+                cacheable_observables.insert(std::make_pair(key, std::make_tuple(cacheable_observable, index)));
 
                 return index;
             }
@@ -171,8 +505,7 @@ namespace eos
             {
                 // add this new regular observable
                 observables.push_back(observable);
-                predictions.push_back(std::numeric_limits<double>::quiet_NaN());
-                regular_observables.push_back(std::make_tuple(observable, index));
+                register_observable(observable, index, Kind::regular);
 
                 return index;
             }
@@ -199,124 +532,66 @@ namespace eos
     void
     ObservableCache::update()
     {
-        // parallelize the evaluation of the observables
-        std::vector<Ticket> cacheable_tickets;
-        cacheable_tickets.reserve(_imp->cacheable_observables.size());
+        // only re-evaluate those observables whose parameters or kinematics changed since the last update,
+        // and evaluate each of them as soon as the observables it relies upon have been evaluated
+        _imp->update_parallel();
+    }
 
-        // evaluate all cacheable observables in parallel
-        for (auto co : _imp->cacheable_observables)
-        {
-            auto f = [=]() {
-                auto & o   = std::get<0>(co.second);
-                auto & idx = std::get<1>(co.second);
-                try
-                {
-                    _imp->predictions[idx] = o->evaluate();
-                }
-                catch (eos::Exception & e)
-                {
-                    Log::instance()->message("ObservableCache::update", ll_error)
-                        << "Exception encountered when evaluating cacheable observable '" << o->name() << "[" << o->kinematics().as_string() << "];" << o->options().as_string() << "': "
-                        << e.what();
-                    _imp->predictions[idx] = std::numeric_limits<double>::quiet_NaN();
+    void
+    ObservableCache::update_batch(const std::vector<Parameter::Id> & ids, const double * points, const std::size_t & n_points, const std::size_t & stride,
+            double * predictions)
+    {
+        if (stride < ids.size())
+            throw InternalError("ObservableCache::update_batch(): Stride is smaller than the number of varied parameters.");
 
-                }
-            };
-            cacheable_tickets.push_back(ThreadPool::instance()->enqueue(std::function<void (void)>(f)));
-        }
+        if (0 == n_points)
+            return;
 
-        std::vector<Ticket> regular_tickets;
-        regular_tickets.reserve(_imp->regular_observables.size());
+        // use one independent clone of this cache per job; evaluation within a job is serial
+        const std::size_t n_jobs = std::min<std::size_t>(ThreadPool::instance()->number_of_threads(), n_points);
+        const std::size_t n_predictions = _imp->observables.size();
 
-        // evaluate all regular observables in parallel
-        for (auto ro : _imp->regular_observables)
+        std::vector<ObservableCache> caches;
+        std::vector<std::vector<Parameter>> varied_parameters;
+        caches.reserve(n_jobs);
+        varied_parameters.reserve(n_jobs);
+        for (std::size_t j = 0 ; j < n_jobs ; ++j)
         {
-            auto f = [=]() {
-                auto & o   = std::get<0>(ro);
-                auto & idx = std::get<1>(ro);
-                try
-                {
-                    _imp->predictions[idx] = o->evaluate();
-                }
-                catch (eos::Exception & e)
-                {
-                    Log::instance()->message("ObservableCache::update", ll_error)
-                        << "Exception encountered when evaluating regular observable '" << o->name() << "[" << o->kinematics().as_string() << "];" << o->options().as_string() << "': "
-                        << e.what();
-                    _imp->predictions[idx] = std::numeric_limits<double>::quiet_NaN();
+            caches.push_back(this->clone(_imp->parameters.clone()));
 
-                }
-            };
-            regular_tickets.push_back(ThreadPool::instance()->enqueue(std::function<void (void)>(f)));
+            std::vector<Parameter> vp;
+            vp.reserve(ids.size());
+            for (const auto & id : ids)
+            {
+                vp.push_back(caches.back().parameters()[id]);
+            }
+            varied_parameters.push_back(std::move(vp));
         }
 
-        // await completion of the cacheable observables
-        for (auto ticket : cacheable_tickets)
+        TaskGroup tasks;
+        for (std::size_t j = 0 ; j < n_jobs ; ++j)
         {
-            ticket.wait();
-        }
+            const std::size_t begin = (j * n_points) / n_jobs, end = ((j + 1) * n_points) / n_jobs;
 
-        std::vector<Ticket> cached_tickets;
-        cached_tickets.reserve(_imp->cached_observables.size());
+            tasks.run([&, j, begin, end]() {
+                auto & cache = caches[j];
+                auto & vp    = varied_parameters[j];
 
-        // evaluate all cached observables in parallel
-        for (auto co : _imp->cached_observables)
-        {
-            auto f = [=]() {
-                auto & o   = std::get<0>(co);
-                auto & idx = std::get<1>(co);
-                try
+                for (std::size_t i = begin ; i < end ; ++i)
                 {
-                    _imp->predictions[idx] = o->evaluate();
-                }
-                catch (eos::Exception & e)
-                {
-                    Log::instance()->message("ObservableCache::update", ll_error)
-                        << "Exception encountered when evaluating cached observable '" << o->name() << "[" << o->kinematics().as_string() << "];" << o->options().as_string() << "': "
-                        << e.what();
-                    _imp->predictions[idx] = std::numeric_limits<double>::quiet_NaN();
+                    for (std::size_t k = 0 ; k < vp.size() ; ++k)
+                    {
+                        vp[k].set(points[i * stride + k]);
+                    }
 
-                }
-            };
-            cached_tickets.push_back(ThreadPool::instance()->enqueue(std::function<void (void)>(f)));
-        }
+                    cache._imp->update_serial();
 
-        // await completion of the regular observables
-        for (auto ticket : regular_tickets)
-        {
-            ticket.wait();
-        }
-
-        // await completion of the cached observables
-        for (auto ticket : cached_tickets)
-        {
-            ticket.wait();
+                    std::copy(cache._imp->predictions.cbegin(), cache._imp->predictions.cend(), predictions + i * n_predictions);
+                }
+            });
         }
 
-        // evaluate all expression observables in a serial fashion
-        //
-        // This is necessary, since an expression observable can rely on
-        // another expression observable, which would be located earlier in
-        // the sequence.
-        // Serial evaluation ensures that no race conditions arise.
-        // There is not reason to optimize this, since expression observables
-        // are evaluated very quickly.
-        for (auto eo : _imp->expression_observables)
-        {
-            auto & o   = std::get<0>(eo);
-            auto & idx = std::get<1>(eo);
-            try
-            {
-                _imp->predictions[idx] = o->evaluate();
-            }
-            catch (eos::Exception & e)
-            {
-                Log::instance()->message("ObservableCache::update", ll_error)
-                    << "Exception encountered when evaluating expression observable '" << o->name() << "[" << o->kinematics().as_string() << "];" << o->options().as_string() << "': "
-                    << e.what();
-                _imp->predictions[idx] = std::numeric_limits<double>::quiet_NaN();
-            }
-        }
+        tasks.wait();
     }
 
     Parameters
@@ -355,6 +630,107 @@ namespace eos
         return _imp->observables.end();
     }
 
+    void
+    ObservableCache::enable_profiling(const bool & enable)
+    {
+        _imp->profiling = enable;
+    }
+
+    std::vector<EvaluationProfile>
+    ObservableCache::profile() const
+    {
+        std::vector<EvaluationProfile> result;
+        result.reserve(_imp->observables.size());
+
+        for (ObservableCache::Id idx = 0 ; idx < _imp->observables.size() ; ++idx)
+        {
+            const auto & t = _imp->timings[idx];
+            result.push_back(EvaluationProfile{ _imp->describe(idx), t.calls, t.exceptions, std::chrono::duration<double>(t.time).count() });
+        }
+
+        return result;
+    }
+
+    void
+    ObservableCache::reset_profile()
+    {
+        std::fill(_imp->timings.begin(), _imp->timings.end(), Implementation<ObservableCache>::Timing());
+    }
+
+    unsigned
+    ObservableCache::enable_polynomial_surrogates(const std::list<std::string> & coefficients)
+    {
+        using Kind = Implementation<ObservableCache>::Kind;
+
+        const ObservableCache::Id n = _imp->observables.size();
+
+        // expressions only rely on the predictions of other observables, and benefit from their surrogates
+        std::vector<ObservablePtr> surrogates(n);
+        for (ObservableCache::Id idx = 0 ; idx < n ; ++idx)
+        {
+            if (Kind::expression == _imp->kinds[idx])
+                continue;
+
+            surrogates[idx] = make_polynomial_surrogate(_imp->observables[idx], coefficients);
+        }
+
+        // a cacheable observable must keep providing its intermediate result as long as any cached observable relies upon it
+        for (ObservableCache::Id idx = 0 ; idx < n ; ++idx)
+        {
+            if ((Kind::cacheable != _imp->kinds[idx]) || (! surrogates[idx]))
+                continue;
+
+            for (const auto & c : _imp->consumers[idx])
+            {
+                if ((Kind::cached == _imp->kinds[c]) && (! surrogates[c]))
+                {
+                    surrogates[idx].reset();
+                    break;
+                }
+            }
+        }
+
+        unsigned result = 0;
+        for (ObservableCache::Id idx = 0 ; idx < n ; ++idx)
+        {
+            if (! surrogates[idx])
+                continue;
+
+            if (Kind::cached == _imp->kinds[idx])
+            {
+                // the surrogate no longer relies on the intermediate result
+                for (const auto & p : _imp->producers[idx])
+                {
+                    auto & consumers = _imp->consumers[p];
+                    consumers.erase(std::remove(consumers.begin(), consumers.end(), idx), consumers.end());
+                }
+                _imp->producers[idx].clear();
+            }
+            else if (Kind::cacheable == _imp->kinds[idx])
+            {
+                // observables added later on must not rely on the replaced observable's intermediate result
+                for (auto c = _imp->cacheable_observables.begin() ; c != _imp->cacheable_observables.end() ; )
+                {
+                    if (std::get<1>(c->second) == idx)
+                        c = _imp->cacheable_observables.erase(c);
+                    else
+                        ++c;
+                }
+            }
+
+            // the surrogate uses the same parameters, and the dependencies therefore remain valid
+            _imp->observables[idx] = surrogates[idx];
+            _imp->kinds[idx]       = Kind::regular;
+            _imp->outdated[idx]    = true;
+            ++result;
+        }
+
+        Log::instance()->message("ObservableCache::enable_polynomial_surrogates", ll_informational)
+            << "Replaced " << result << " out of " << n << " observables by polynomial surrogates";
+
+        return result;
+    }
+
     ObservableCache
     ObservableCache::clone(const Parameters & parameters) const
     {
@@ -364,7 +740,7 @@ namespace eos
         {
             // cloning cached observables creates independent *cacheable* observables
             // adding them back creates new and independent cached observables
-            result._imp->add((*o)->clone(parameters), *this);
+            result._imp->add((*o)->clone(parameters), result);
         }
 
         result.update();
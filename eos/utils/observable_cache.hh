@@ -26,8 +26,30 @@
 #include <eos/utils/parameters.hh>
 #include <eos/utils/private_implementation_pattern.hh>
 
+#include <list>
+#include <string>
+#include <vector>
+
 namespace eos
 {
+    /*!
+     * Holds the profiling information for the evaluation of one observable or one likelihood block.
+     */
+    struct EvaluationProfile
+    {
+        /// The name of the observable or likelihood block.
+        std::string name;
+
+        /// The number of evaluations.
+        unsigned long calls;
+
+        /// The number of evaluations that raised an exception.
+        unsigned long exceptions;
+
+        /// The accumulated wall time of all evaluations, in seconds.
+        double time;
+    };
+
     class ObservableCache :
         public PrivateImplementationPattern<ObservableCache>
     {
@@ -56,9 +78,34 @@ namespace eos
              */
             Id add(const ObservablePtr & observable);
 
-            /// Update the predictions for all observables.
+            /*!
+             * Update the predictions for all observables.
+             *
+             * Only those observables are re-evaluated whose parameters or kinematic
+             * variables have changed since the last update.
+             *
+             * Cached and expression observables depend on the observables that provide
+             * their intermediate results or predictions. Each observable is evaluated
+             * on the thread pool as soon as all of its dependencies have been evaluated.
+             */
             void update();
 
+            /*!
+             * Update the predictions for all observables at a batch of parameter points.
+             *
+             * The parameter points are distributed across the thread pool. Each job
+             * evaluates its share of points on an independent clone of this cache.
+             * The predictions stored in this cache are not changed.
+             *
+             * @param ids         The ids of the varied parameters, corresponding to the columns of the points.
+             * @param points      Row-major matrix of the values of the varied parameters, with one row per point.
+             * @param n_points    The number of points, i.e., the number of rows.
+             * @param stride      The distance between two subsequent rows of points; must be at least ids.size().
+             * @param predictions Row-major matrix of n_points x size() entries, into which the predictions are written.
+             */
+            void update_batch(const std::vector<Parameter::Id> & ids, const double * points, const std::size_t & n_points, const std::size_t & stride,
+                    double * predictions);
+
             /// Retrieve the cache's common Parameters object.
             Parameters parameters() const;
 
@@ -85,6 +132,44 @@ namespace eos
             Iterator end() const;
             ///@}
 
+            ///@name Profiling
+            ///@{
+            /*!
+             * Enable or disable the profiling of the observables' evaluations.
+             *
+             * While enabled, each update records the number of evaluations, the number of
+             * evaluations that raised an exception, and the wall time spent for every observable.
+             * Profiling is disabled by default, and is not inherited by clones.
+             *
+             * @param enable Whether the evaluations shall be profiled.
+             */
+            void enable_profiling(const bool & enable = true);
+
+            /// Retrieve the profiling information, with one entry per observable in the order of their ids.
+            std::vector<EvaluationProfile> profile() const;
+
+            /// Discard all profiling information recorded so far.
+            void reset_profile();
+            ///@}
+
+            ///@name Polynomial Surrogates
+            ///@{
+            /*!
+             * Replace eligible observables by polynomial surrogates in the given coefficients.
+             *
+             * An observable is eligible if its dependence on the coefficients is reproduced by a
+             * polynomial of at most second order; see make_polynomial_surrogate(). Each polynomial
+             * is reconstructed only when any other parameter or kinematic variable of its observable
+             * changes. Expression observables are never replaced, and cacheable observables are
+             * only replaced together with all observables that rely on their intermediate results.
+             * All ids remain valid. The replacements are inherited by clones.
+             *
+             * @param coefficients The names of the coefficients, e.g. the varied Wilson coefficients.
+             * @return The number of observables that have been replaced.
+             */
+            unsigned enable_polynomial_surrogates(const std::list<std::string> & coefficients);
+            ///@}
+
             /// Clone this cache whilst keeping the observables in the given order, i.e. all ids remain valid.
             ObservableCache clone(const Parameters & parameters) const;
     };
@@ -22,14 +22,19 @@
 #include <config.h>
 
 #include <eos/utils/cartesian-product.hh>
+#include <eos/utils/database-image.hh>
+#include <eos/utils/lock.hh>
 #include <eos/utils/log.hh>
+#include <eos/utils/mutex.hh>
 #include <eos/utils/parameters.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
 #include <eos/utils/qualified-name.hh>
 #include <eos/utils/stringify.hh>
 #include <eos/utils/wrapped_forward_iterator-impl.hh>
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <map>
 #include <random>
 #include <vector>
@@ -176,34 +181,108 @@ namespace eos
 
     struct Parameter::Template
     {
-        QualifiedName name;
+        // the name is never modified, and therefore shared among all copies of the metadata
+        std::shared_ptr<const QualifiedName> name;
 
         double min, central, max;
 
         std::string latex;
 
         Unit unit;
+
+        Template(const QualifiedName & name, const double & min, const double & central, const double & max,
+                const std::string & latex, const Unit & unit) :
+            name(std::make_shared<const QualifiedName>(name)),
+            min(min),
+            central(central),
+            max(max),
+            latex(latex),
+            unit(unit)
+        {
+        }
     };
 
-    struct Parameter::Data :
-        Parameter::Template
+    struct Parameters::Metadata
     {
-        double value, generator_value;
+        std::vector<Parameter::Template> templates;
 
-        Parameter::Id id;
-
-        Data(const Parameter::Template & t, const Parameter::Id & i) :
-            Parameter::Template(t),
-            value(t.central),
-            generator_value(0.0),
-            id(i)
-        {
-        }
+        std::map<QualifiedName, unsigned> indices;
     };
 
     struct Parameters::Data
     {
-        std::vector<Parameter::Data> data;
+        // the metadata is shared among clones, and copied before any modification while shared
+        std::shared_ptr<Parameters::Metadata> metadata;
+
+        std::vector<double> values;
+
+        std::vector<double> generator_values;
+
+        // the generation at the last change of each value
+        std::vector<unsigned long> generations;
+
+        // increases with every change of any parameter's value
+        unsigned long generation = 0;
+
+        // the number of live views, which pin the values in place and bypass the change tracking
+        unsigned views = 0;
+
+        Data() :
+            metadata(new Parameters::Metadata)
+        {
+        }
+
+        // copies the values, but not the views
+        Data(const Data & other) :
+            metadata(other.metadata),
+            values(other.values),
+            generator_values(other.generator_values),
+            generations(other.generations),
+            generation(other.generation)
+        {
+        }
+
+        // mark all values as changed
+        void touch()
+        {
+            ++generation;
+            std::fill(generations.begin(), generations.end(), generation);
+        }
+
+        inline void set(const unsigned & index, const double & value)
+        {
+            values[index] = value;
+            generations[index] = ++generation;
+        }
+
+        Parameters::Metadata & mutable_metadata()
+        {
+            if (metadata.use_count() > 1)
+            {
+                metadata = std::make_shared<Parameters::Metadata>(*metadata);
+            }
+
+            return *metadata;
+        }
+
+        unsigned add(const Parameter::Template & t)
+        {
+            // adding a value might move the values away from under the views
+            if (views > 0)
+                throw ParameterViewError(*t.name);
+
+            auto & m = mutable_metadata();
+
+            const unsigned index = m.templates.size();
+            m.templates.push_back(t);
+            m.indices[*t.name] = index;
+
+            values.push_back(t.central);
+            generator_values.push_back(0.0);
+            generations.push_back(0);
+
+            return index;
+        }
     };
 
     template <>
@@ -225,30 +304,29 @@ namespace eos
     {
         std::shared_ptr<Parameters::Data> parameters_data;
 
-        std::map<QualifiedName, unsigned> parameters_map;
-
         std::vector<Parameter> parameters;
 
         std::vector<ParameterSection> sections;
 
+        // Objects shared among all users of these parameters, identified by type and key
+        Mutex shared_objects_mutex;
+        std::map<std::pair<std::type_index, std::string>, std::weak_ptr<void>> shared_objects;
+
         Implementation(const std::initializer_list<Parameter::Template> & list) :
             parameters_data(new Parameters::Data)
         {
-            unsigned idx(0);
-            for (auto i(list.begin()), i_end(list.end()) ; i != i_end ; ++i, ++idx)
+            for (const auto & t : list)
             {
-                parameters_data->data.push_back(Parameter::Data(*i, idx));
-                parameters_map[i->name] = idx;
-                parameters.push_back(Parameter(parameters_data, idx));
+                parameters.push_back(Parameter(parameters_data, parameters_data->add(t)));
             }
         }
 
+        // copies only the values, while the metadata remains shared
         Implementation(const Implementation & other) :
-            parameters_data(new Parameters::Data(*other.parameters_data)),
-            parameters_map(other.parameters_map)
+            parameters_data(new Parameters::Data(*other.parameters_data))
         {
             parameters.reserve(other.parameters.size());
-            for (unsigned i = 0 ; i != parameters.size() ; ++i)
+            for (unsigned i = 0 ; i != other.parameters.size() ; ++i)
             {
                 parameters.push_back(Parameter(parameters_data, i));
             }
@@ -331,28 +409,33 @@ namespace eos
                         unit = Unit(unit_node.as<std::string>());
                     }
 
-                    auto i = parameters_map.find(name);
-                    if (parameters_map.end() != i)
+                    auto i = parameters_data->metadata->indices.find(name);
+                    if (parameters_data->metadata->indices.end() != i)
                     {
                         Log::instance()->message("[parameters.override]", ll_informational)
                             << "Overriding existing parameter '" << name << "' with central value '" << central << "'";
 
-                        parameters_data->data[i->second].value = central;
-                        if (has_min)
-                        {
-                            parameters_data->data[i->second].min = min;
-                        }
-                        if (has_max)
-                        {
-                            parameters_data->data[i->second].max = max;
-                        }
-                        if (has_latex)
-                        {
-                            parameters_data->data[i->second].latex = latex;
-                        }
-                        if (has_unit)
+                        const unsigned idx = i->second;
+                        parameters_data->set(idx, central);
+                        if (has_min || has_max || has_latex || has_unit)
                         {
-                            parameters_data->data[i->second].unit = unit;
+                            auto & t = parameters_data->mutable_metadata().templates[idx];
+                            if (has_min)
+                            {
+                                t.min = min;
+                            }
+                            if (has_max)
+                            {
+                                t.max = max;
+                            }
+                            if (has_latex)
+                            {
+                                t.latex = latex;
+                            }
+                            if (has_unit)
+                            {
+                                t.unit = unit;
+                            }
                         }
                     }
                     else
@@ -369,9 +452,7 @@ namespace eos
                             max = central;
                         }
 
-                        auto idx = parameters_data->data.size();
-                        parameters_data->data.push_back(Parameter::Data(Parameter::Template { QualifiedName(name), min, central, max, latex, unit }, idx));
-                        parameters_map[name] = idx;
+                        auto idx = parameters_data->add(Parameter::Template { QualifiedName(name), min, central, max, latex, unit });
                         parameters.push_back(Parameter(parameters_data, idx));
                     }
                 }
@@ -382,8 +463,8 @@ namespace eos
             }
         }
 
-        void
-        load_defaults()
+        static fs::path
+        base_directory()
         {
             fs::path base;
             if (std::getenv("EOS_TESTS_PARAMETERS"))
@@ -411,7 +492,108 @@ namespace eos
                 throw InternalError("Expect '" + base.string() + " to be a directory");
             }
 
-            unsigned idx = parameters.size();
+            return base;
+        }
+
+        void
+        load_defaults()
+        {
+            const fs::path base = base_directory();
+
+            // prefer the precompiled image, unless it is missing or stale
+            auto image = DatabaseImage::open((base / "parameters.eosdb").string(), DatabaseImage::fingerprint(base.string(), ".yaml"));
+            if (image)
+            {
+                load_image(*image);
+            }
+            else
+            {
+                load_yaml(base);
+            }
+        }
+
+        void
+        load_image(const DatabaseImage & image)
+        {
+            auto cursor = image.cursor();
+            for (std::uint64_t s = 0, s_end = cursor.read_uint() ; s < s_end ; ++s)
+            {
+                std::vector<ParameterGroup> section_groups;
+
+                const std::string section_title(cursor.read_string());
+                const std::string section_desc(cursor.read_string());
+
+                for (std::uint64_t g = 0, g_end = cursor.read_uint() ; g < g_end ; ++g)
+                {
+                    std::vector<Parameter> group_parameters;
+
+                    const std::string group_title(cursor.read_string());
+                    const std::string group_desc(cursor.read_string());
+
+                    for (std::uint64_t p = 0, p_end = cursor.read_uint() ; p < p_end ; ++p)
+                    {
+                        const std::string name(cursor.read_string());
+                        const double min     = cursor.read_double();
+                        const double central = cursor.read_double();
+                        const double max     = cursor.read_double();
+                        const std::string latex(cursor.read_string());
+                        const Unit unit(static_cast<Unit::Id>(cursor.read_uint()));
+
+                        const unsigned idx = parameters_data->add(Parameter::Template { QualifiedName(name), min, central, max, latex, unit });
+                        parameters.push_back(Parameter(parameters_data, idx));
+                        group_parameters.push_back(Parameter(parameters_data, idx));
+                    }
+
+                    section_groups.push_back(ParameterGroup(new Implementation<ParameterGroup>(group_title, group_desc, std::move(group_parameters))));
+                }
+                sections.push_back(ParameterSection(new Implementation<ParameterSection>(section_title, section_desc, std::move(section_groups))));
+            }
+        }
+
+        void
+        write_image(DatabaseImageWriter & writer) const
+        {
+            writer.write_uint(sections.size());
+            for (const auto & section : sections)
+            {
+                writer.write_string(section.name());
+                writer.write_string(section.description());
+
+                std::uint64_t number_of_groups = 0;
+                for (auto g = section.begin(), g_end = section.end() ; g != g_end ; ++g)
+                {
+                    ++number_of_groups;
+                }
+                writer.write_uint(number_of_groups);
+
+                for (const auto & group : section)
+                {
+                    writer.write_string(group.name());
+                    writer.write_string(group.description());
+
+                    std::uint64_t number_of_parameters = 0;
+                    for (auto p = group.begin(), p_end = group.end() ; p != p_end ; ++p)
+                    {
+                        ++number_of_parameters;
+                    }
+                    writer.write_uint(number_of_parameters);
+
+                    for (const auto & p : group)
+                    {
+                        writer.write_string(p.name());
+                        writer.write_double(p.min());
+                        writer.write_double(p.central());
+                        writer.write_double(p.max());
+                        writer.write_string(p.latex());
+                        writer.write_uint(static_cast<std::uint64_t>(p.unit().id()));
+                    }
+                }
+            }
+        }
+
+        void
+        load_yaml(const fs::path & base)
+        {
             for (fs::directory_iterator f(base), f_end ; f != f_end ; ++f)
             {
                 auto file_path = f->path();
@@ -525,17 +707,14 @@ namespace eos
 
                             if (name.find("%") == std::string::npos) // The parameter is not templated
                             {
-                                if (parameters_map.end() != parameters_map.find(name))
+                                if (parameters_data->metadata->indices.end() != parameters_data->metadata->indices.find(name))
                                 {
                                     throw ParameterInputDuplicateError(file, name);
                                 }
 
-                                parameters_data->data.push_back(Parameter::Data(Parameter::Template { QualifiedName(name), min, central, max, latex, unit }, idx));
-                                parameters_map[name] = idx;
+                                const unsigned idx = parameters_data->add(Parameter::Template { QualifiedName(name), min, central, max, latex, unit });
                                 parameters.push_back(Parameter(parameters_data, idx));
                                 group_parameters.push_back(Parameter(parameters_data, idx));
-
-                                ++idx;
                             }
                             else // The parameter is templated
                             {
@@ -577,17 +756,14 @@ namespace eos
 
                                         QualifiedName qn(templated_name.str());
 
-                                        if (parameters_map.end() != parameters_map.find(qn))
+                                        if (parameters_data->metadata->indices.end() != parameters_data->metadata->indices.find(qn))
                                         {
                                             throw ParameterInputDuplicateError(file, qn.str());
                                         }
 
-                                        parameters_data->data.push_back(Parameter::Data(Parameter::Template { qn, min, central, max, templated_latex.str(), unit }, idx));
-                                        parameters_map[templated_name.str()] = idx;
+                                        const unsigned idx = parameters_data->add(Parameter::Template { qn, min, central, max, templated_latex.str(), unit });
                                         parameters.push_back(Parameter(parameters_data, idx));
                                         group_parameters.push_back(Parameter(parameters_data, idx));
-
-                                        ++idx;
                                     }
                                 }
                             }
@@ -623,9 +799,9 @@ namespace eos
     Parameter
     Parameters::operator[] (const QualifiedName & name) const
     {
-        auto i(_imp->parameters_map.find(name));
+        auto i(_imp->parameters_data->metadata->indices.find(name));
 
-        if (_imp->parameters_map.end() == i)
+        if (_imp->parameters_data->metadata->indices.end() == i)
             throw UnknownParameterError(name);
 
         return Parameter(_imp->parameters_data, i->second);
@@ -644,14 +820,12 @@ namespace eos
     Parameters::declare(const QualifiedName & name, double value)
     {
         // return existing parameter
-        auto i(_imp->parameters_map.find(name));
-        if (_imp->parameters_map.end() != i)
+        auto i(_imp->parameters_data->metadata->indices.find(name));
+        if (_imp->parameters_data->metadata->indices.end() != i)
             return Parameter(_imp->parameters_data, i->second);
 
         // create new parameter
-        unsigned idx = _imp->parameters.size();
-        _imp->parameters_data->data.push_back(Parameter::Data(Parameter::Template { name, value, value, value, "LaTeX display not supported for run-time declared parameters", Unit::Undefined() }, idx));
-        _imp->parameters_map[name] = idx;
+        unsigned idx = _imp->parameters_data->add(Parameter::Template { name, value, value, value, "LaTeX display not supported for run-time declared parameters", Unit::Undefined() });
         _imp->parameters.push_back(Parameter(_imp->parameters_data, idx));
 
         return _imp->parameters.back();
@@ -660,20 +834,20 @@ namespace eos
     void
     Parameters::set(const QualifiedName & name, const double & value)
     {
-        auto i(_imp->parameters_map.find(name));
+        auto i(_imp->parameters_data->metadata->indices.find(name));
 
-        if (_imp->parameters_map.end() == i)
+        if (_imp->parameters_data->metadata->indices.end() == i)
             throw UnknownParameterError(name);
 
-        _imp->parameters_data->data[i->second].value = value;
+        _imp->parameters_data->set(i->second, value);
     }
 
     bool
     Parameters::has(const QualifiedName & name)
     {
-        auto i(_imp->parameters_map.find(name));
+        auto i(_imp->parameters_data->metadata->indices.find(name));
 
-        if (_imp->parameters_map.end() == i)
+        if (_imp->parameters_data->metadata->indices.end() == i)
             return false;
         else return true;
     }
@@ -708,6 +882,89 @@ namespace eos
         return rhs._imp.get() != this->_imp.get();
     }
 
+    std::shared_ptr<Parameters::View>
+    Parameters::view() const
+    {
+        return std::make_shared<Parameters::View>(_imp->parameters_data);
+    }
+
+    unsigned long
+    Parameters::generation() const
+    {
+        auto & data = *_imp->parameters_data;
+
+        // changes through views are not tracked; report a new generation upon each query
+        if (data.views > 0)
+            return ++data.generation;
+
+        return data.generation;
+    }
+
+    Parameters::View::View(const std::shared_ptr<Parameters::Data> & data) :
+        _data(data)
+    {
+        ++_data->views;
+    }
+
+    Parameters::View::~View()
+    {
+        --_data->views;
+
+        // make all changes through the views visible
+        if (0 == _data->views)
+            _data->touch();
+    }
+
+    std::size_t
+    Parameters::View::size() const
+    {
+        return _data->values.size();
+    }
+
+    double *
+    Parameters::View::values() const
+    {
+        return _data->values.data();
+    }
+
+    double *
+    Parameters::View::generator_values() const
+    {
+        return _data->generator_values.data();
+    }
+
+    std::shared_ptr<void>
+    Parameters::shared_object(const std::type_index & type, const std::string & key,
+            const std::function<std::shared_ptr<void> ()> & factory) const
+    {
+        const auto index = std::make_pair(type, key);
+
+        {
+            Lock l(_imp->shared_objects_mutex);
+
+            auto i = _imp->shared_objects.find(index);
+            if (_imp->shared_objects.end() != i)
+            {
+                if (auto result = i->second.lock())
+                    return result;
+            }
+        }
+
+        // create the object without holding the lock, since its construction might require further shared objects
+        auto result = factory();
+
+        Lock l(_imp->shared_objects_mutex);
+
+        // another thread might have created the same object in the meantime
+        auto & entry = _imp->shared_objects[index];
+        if (auto existing = entry.lock())
+            return existing;
+
+        entry = result;
+
+        return result;
+    }
+
     Parameters
     Parameters::Defaults()
     {
@@ -717,6 +974,20 @@ namespace eos
         return Parameters(imp);
     }
 
+    void
+    Parameters::compile_image(const std::string & file)
+    {
+        const fs::path base = Implementation<Parameters>::base_directory();
+        const std::uint64_t fingerprint = DatabaseImage::fingerprint(base.string(), ".yaml");
+
+        Implementation<Parameters> imp{};
+        imp.load_yaml(base);
+
+        DatabaseImageWriter writer;
+        imp.write_image(writer);
+        writer.save(file, fingerprint);
+    }
+
     void
     Parameters::override_from_file(const std::string & file)
     {
@@ -725,13 +996,15 @@ namespace eos
 
     Parameter::Parameter(const std::shared_ptr<Parameters::Data> & parameters_data, unsigned index) :
         _parameters_data(parameters_data),
-        _index(index)
+        _index(index),
+        _name(parameters_data->metadata->templates[index].name)
     {
     }
 
     Parameter::Parameter(const Parameter & other) :
         _parameters_data(other._parameters_data),
-        _index(other._index)
+        _index(other._index),
+        _name(other._name)
     {
     }
 
@@ -747,31 +1020,31 @@ namespace eos
 
     Parameter::operator double () const
     {
-        return _parameters_data->data[_index].value;
+        return _parameters_data->values[_index];
     }
 
     double
     Parameter::operator() () const
     {
-        return _parameters_data->data[_index].value;
+        return _parameters_data->values[_index];
     }
 
     double
     Parameter::evaluate() const
     {
-        return _parameters_data->data[_index].value;
+        return _parameters_data->values[_index];
     }
 
     double
     Parameter::evaluate_generator() const
     {
-        return _parameters_data->data[_index].generator_value;
+        return _parameters_data->generator_values[_index];
     }
 
     const Parameter &
     Parameter::operator= (const double & value)
     {
-        _parameters_data->data[_index].value = value;
+        _parameters_data->set(_index, value);
 
         return *this;
     }
@@ -779,67 +1052,77 @@ namespace eos
     void
     Parameter::set(const double & value)
     {
-        _parameters_data->data[_index].value = value;
+        _parameters_data->set(_index, value);
     }
 
     void
     Parameter::set_generator(const double & value)
     {
-        _parameters_data->data[_index].generator_value = value;
+        _parameters_data->generator_values[_index] = value;
+    }
+
+    unsigned long
+    Parameter::generation() const
+    {
+        // changes through views are not tracked; report the value as changed
+        if (_parameters_data->views > 0)
+            return std::numeric_limits<unsigned long>::max();
+
+        return _parameters_data->generations[_index];
     }
 
-    const double &
+    double
     Parameter::central() const
     {
-        return _parameters_data->data[_index].central;
+        return _parameters_data->metadata->templates[_index].central;
     }
 
-    const double &
+    double
     Parameter::max() const
     {
-        return _parameters_data->data[_index].max;
+        return _parameters_data->metadata->templates[_index].max;
     }
 
     void
     Parameter::set_max(const double & value)
     {
-        _parameters_data->data[_index].max = value;
+        _parameters_data->mutable_metadata().templates[_index].max = value;
     }
 
-    const double &
+    double
     Parameter::min() const
     {
-        return _parameters_data->data[_index].min;
+        return _parameters_data->metadata->templates[_index].min;
     }
 
     void
     Parameter::set_min(const double & value)
     {
-        _parameters_data->data[_index].min = value;
+        _parameters_data->mutable_metadata().templates[_index].min = value;
     }
 
     const std::string &
     Parameter::name() const
     {
-        return _parameters_data->data[_index].name.str();
+        return _name->str();
     }
 
-    const std::string &
+    std::string
     Parameter::latex() const
     {
-        return _parameters_data->data[_index].latex;
+        return _parameters_data->metadata->templates[_index].latex;
     }
 
     Unit
     Parameter::unit() const
     {
-        return _parameters_data->data[_index].unit;
+        return _parameters_data->metadata->templates[_index].unit;
     }
 
     Parameter::Id
     Parameter::id() const
     {
-        return _parameters_data->data[_index].id;
+        return _index;
     }
 
     /* ParameterUser */
@@ -881,6 +1164,27 @@ namespace eos
         _ids.insert(other._ids.cbegin(), other._ids.cend());
     }
 
+    bool
+    ParameterUser::changed_since(const Parameters & parameters, const unsigned long & generation) const
+    {
+        const auto & data = *parameters._imp->parameters_data;
+
+        // changes through views are not tracked
+        if (data.views > 0)
+            return true;
+
+        if (data.generation <= generation)
+            return false;
+
+        for (const auto & id : _ids)
+        {
+            if (data.generations[id] > generation)
+                return true;
+        }
+
+        return false;
+    }
+
     UsedParameter::UsedParameter(const Parameter & parameter, ParameterUser & user) :
         Parameter(parameter)
     {
@@ -906,4 +1210,9 @@ namespace eos
         Exception("Malformed parameter input file '" + file + "': Duplicate entry for parameter '" + node + "'")
     {
     }
+
+    ParameterViewError::ParameterViewError(const QualifiedName & name) throw () :
+        Exception("Cannot declare parameter '" + name.full() + "' while a view of the parameters exists")
+    {
+    }
 }
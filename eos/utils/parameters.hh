@@ -29,7 +29,11 @@
 #include <eos/utils/units.hh>
 #include <eos/utils/wrapped_forward_iterator.hh>
 
+#include <functional>
+#include <memory>
 #include <set>
+#include <string>
+#include <typeindex>
 
 namespace eos
 {
@@ -73,6 +77,16 @@ namespace eos
         ParameterInputDuplicateError(const std::string & file, const std::string & msg) throw ();
     };
 
+    /*!
+     * ParameterViewError is thrown when a new parameter is declared while a view of
+     * the parameters' values exists.
+     */
+    struct ParameterViewError :
+        public Exception
+    {
+        ParameterViewError(const QualifiedName & name) throw ();
+    };
+
     /*!
      * Parameters keeps the set of all numeric parameters for any Observable.
      *
@@ -87,6 +101,7 @@ namespace eos
             ///@name Internal Data
             ///@{
             struct Data;
+            struct Metadata;
             ///@}
 
             ///@name Basic Functions
@@ -104,6 +119,7 @@ namespace eos
 
         public:
             friend class Parameter;
+            friend class ParameterUser;
             friend struct Implementation<Parameter>;
             friend struct Implementation<Parameters>;
 
@@ -116,6 +132,16 @@ namespace eos
              */
             static Parameters Defaults();
 
+            /*!
+             * Compile the default parameters into a binary database image.
+             *
+             * Defaults() uses the image 'parameters.eosdb' in the directory of the parameter input files
+             * in place of the input files, as long as the latter remain unchanged.
+             *
+             * @param file The name of the image file.
+             */
+            static void compile_image(const std::string & file);
+
             Parameters clone() const;
             /*!
              * Destructor.
@@ -146,6 +172,8 @@ namespace eos
             /*!
              * Declare a new parameter.
              *
+             * Throws ParameterViewError if the parameter is new and any view of these parameters exists.
+             *
              * @param name  Name of the new parameter to be declared.
              * @param value (Optional) value for the new parameter.
              */
@@ -188,6 +216,47 @@ namespace eos
             void override_from_file(const std::string & file);
             ///@}
 
+            ///@name Bulk access
+            ///@{
+            class View;
+
+            /*!
+             * Create a view of the contiguous numeric values and generator values of all parameters.
+             *
+             * See Parameters::View for the restrictions that apply while the view exists.
+             */
+            std::shared_ptr<View> view() const;
+            ///@}
+
+            ///@name Change tracking
+            ///@{
+            /*!
+             * Retrieve the current generation of this set of parameters.
+             *
+             * The generation increases monotonically with every change of any parameter's numeric value.
+             * While any view of the parameters exists, each call yields a new generation.
+             */
+            unsigned long generation() const;
+            ///@}
+
+            ///@name Shared objects
+            ///@{
+            /*!
+             * Retrieve an object that is shared among all users of this set of parameters.
+             *
+             * The object is identified by its type and a key. If no such object is
+             * currently alive, a new object is created using the factory. Only a weak
+             * reference to the object is kept, and clones of this set of parameters
+             * start out without any shared objects.
+             *
+             * @param type    The type of the shared object.
+             * @param key     The key that identifies the shared object among all objects of the same type.
+             * @param factory The function that creates a new object if needed.
+             */
+            std::shared_ptr<void> shared_object(const std::type_index & type, const std::string & key,
+                    const std::function<std::shared_ptr<void> ()> & factory) const;
+            ///@}
+
             /*!
              * Compare two instances of Parameters on inequality of their
              * underlying implementations.
@@ -199,6 +268,47 @@ namespace eos
 
     extern template class WrappedForwardIterator<Parameters::IteratorTag, Parameter>;
 
+    /*!
+     * A view of the contiguous numeric values and generator values of all parameters,
+     * indexed by the parameters' ids.
+     *
+     * The view keeps the arrays alive and in place: while any view exists, declaring a
+     * new parameter throws ParameterViewError. Changes through the view bypass the change
+     * tracking. While any view exists, all parameters are therefore reported as changed
+     * whenever their generations are queried, and upon destruction of the last view all
+     * parameters are marked as changed.
+     */
+    class Parameters::View
+    {
+        private:
+            std::shared_ptr<Parameters::Data> _data;
+
+        public:
+            ///@name Basic Functions
+            ///@{
+            /// Constructor. Use Parameters::view() instead.
+            View(const std::shared_ptr<Parameters::Data> & data);
+
+            /// Destructor.
+            ~View();
+
+            View(const View &) = delete;
+            View & operator= (const View &) = delete;
+            ///@}
+
+            ///@name Access
+            ///@{
+            /// Retrieve the number of parameters.
+            std::size_t size() const;
+
+            /// Retrieve the array of numeric values.
+            double * values() const;
+
+            /// Retrieve the array of generator values.
+            double * generator_values() const;
+            ///@}
+    };
+
     /*!
      * Parameter is the class that holds all information of one of Parameters' parameters.
      */
@@ -206,7 +316,6 @@ namespace eos
         public Mutable
     {
         private:
-            struct Data;
             struct Template;
 
             ///@name Internal Data
@@ -214,6 +323,9 @@ namespace eos
             std::shared_ptr<Parameters::Data> _parameters_data;
 
             unsigned _index;
+
+            // shared with the metadata, but never copied along with it
+            std::shared_ptr<const QualifiedName> _name;
             ///@}
 
             ///@name Basic Functions
@@ -264,6 +376,15 @@ namespace eos
 
             /// Set a Parameter's generator value, used for prior sampling.
             virtual void set_generator(const double &);
+
+            /*!
+             * Retrieve the generation of the parent Parameters object at which this Parameter's
+             * numeric value was last changed.
+             *
+             * While any view of the parameters exists, the generation is newer than any generation
+             * of the parent Parameters object.
+             */
+            unsigned long generation() const;
             ///@}
 
             ///@name Access to Meta Data
@@ -272,16 +393,16 @@ namespace eos
             virtual const std::string & name() const;
 
             /// Retrieve the Parameter's (default) central value.
-            const double & central() const;
+            double central() const;
 
             /// Retrieve the Parameter's (default) maximal value.
-            const double & max() const;
+            double max() const;
 
             /// Set the Parameter's maximal value.
             void set_max(const double &);
 
             /// Retrieve the Parameter's (default) minimal value.
-            const double & min() const;
+            double min() const;
 
             /// Set the Parameter's maximal value.
             void set_min(const double &);
@@ -290,7 +411,7 @@ namespace eos
             Id id() const;
 
             /// Retrieve the Parameter's name as a LaTeX representation
-            const std::string & latex() const;
+            std::string latex() const;
 
             /// Retrieve the Parameter's unit
             Unit unit() const;
@@ -395,6 +516,14 @@ namespace eos
              * @param user The other ParameterUser whose ids we are going to copy.
              */
             void uses(const ParameterUser & user);
+
+            /*!
+             * Determine if any of our used parameters has changed since a given generation.
+             *
+             * @param parameters The Parameters object that our used ids refer to.
+             * @param generation The generation of the Parameters object against which we compare.
+             */
+            bool changed_since(const Parameters & parameters, const unsigned long & generation) const;
             ///@}
     };
 
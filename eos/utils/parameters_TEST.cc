@@ -21,6 +21,9 @@
 #include <test/test.hh>
 #include <eos/utils/parameters.hh>
 
+#include <iterator>
+#include <memory>
+
 using namespace test;
 using namespace eos;
 
@@ -73,6 +76,160 @@ class ParametersTest :
                 TEST_CHECK_EQUAL(m_c_clone(), m_c_clone.central());
             }
 
+            // Cloning shares the metadata until it is modified
+            {
+                Parameters original = Parameters::Defaults();
+                Parameters clone = original.clone();
+
+                Parameter m_c_original = original["mass::c"];
+                Parameter m_c_clone = clone["mass::c"];
+                TEST_CHECK_EQUAL(&m_c_original.name(), &m_c_clone.name());
+
+                const double min = m_c_original.min();
+                m_c_clone.set_min(0.5);
+                TEST_CHECK_EQUAL(m_c_clone.min(), 0.5);
+                TEST_CHECK_EQUAL(m_c_original.min(), min);
+                TEST_CHECK_EQUAL(m_c_original.name(), m_c_clone.name());
+
+                clone.declare("test::declared", 1.0);
+                TEST_CHECK_EQUAL(clone.has("test::declared"), true);
+                TEST_CHECK_EQUAL(original.has("test::declared"), false);
+                TEST_CHECK_EQUAL(clone["test::declared"].evaluate(), 1.0);
+            }
+
+            // Names outlive copies of the metadata
+            {
+                Parameters original = Parameters::Defaults();
+                Parameter m_c = original["mass::c"];
+                const std::string & name = m_c.name();
+
+                {
+                    // the clone keeps the original metadata, while the original receives a copy
+                    Parameters clone = original.clone();
+                    m_c.set_min(0.5);
+                    original.declare("test::declared", 1.0);
+                }
+
+                // the last owner of the original metadata is gone
+                TEST_CHECK_EQUAL(&name, &m_c.name());
+                TEST_CHECK_EQUAL(name, "mass::c");
+            }
+
+            // Generations
+            {
+                Parameters p = Parameters::Defaults();
+                Parameter m_c = p["mass::c"];
+                Parameter m_b = p["mass::b(MSbar)"];
+
+                ParameterUser user;
+                user.uses(m_c.id());
+
+                const auto generation = p.generation();
+                TEST_CHECK_EQUAL(user.changed_since(p, generation), false);
+
+                m_b = 4.0;
+                TEST_CHECK(p.generation() > generation);
+                TEST_CHECK_EQUAL(m_b.generation(), p.generation());
+                TEST_CHECK_EQUAL(user.changed_since(p, generation), false);
+
+                p.set("mass::c", 1.2);
+                TEST_CHECK_EQUAL(m_c.generation(), p.generation());
+                TEST_CHECK_EQUAL(user.changed_since(p, generation), true);
+                TEST_CHECK_EQUAL(user.changed_since(p, p.generation()), false);
+
+                // clones continue counting independently
+                Parameters clone = p.clone();
+                TEST_CHECK_EQUAL(clone.generation(), p.generation());
+                clone["mass::c"] = 1.3;
+                TEST_CHECK(clone.generation() > p.generation());
+                TEST_CHECK_EQUAL(user.changed_since(p, p.generation()), false);
+            }
+
+            // Bulk access
+            {
+                Parameters p = Parameters::Defaults();
+                Parameter m_c = p["mass::c"];
+                Parameter m_b = p["mass::b(MSbar)"];
+
+                ParameterUser user;
+                user.uses(m_c.id());
+
+                const auto generation = p.generation();
+                {
+                    auto view = p.view();
+                    TEST_CHECK_EQUAL(view->size(), std::size_t(std::distance(p.begin(), p.end())));
+                    TEST_CHECK_EQUAL(view->values()[m_c.id()], m_c.evaluate());
+
+                    m_b = 4.0;
+                    TEST_CHECK_EQUAL(view->values()[m_b.id()], 4.0);
+
+                    m_c.set_generator(0.25);
+                    TEST_CHECK_EQUAL(view->generator_values()[m_c.id()], 0.25);
+                    view->generator_values()[m_c.id()] = 0.75;
+                    TEST_CHECK_EQUAL(m_c.evaluate_generator(), 0.75);
+
+                    // changes through the view are not tracked, and all parameters are reported as changed
+                    view->values()[m_c.id()] = 1.1;
+                    TEST_CHECK_EQUAL(m_c.evaluate(), 1.1);
+                    TEST_CHECK_EQUAL(user.changed_since(p, p.generation()), true);
+                    TEST_CHECK(m_c.generation() > p.generation());
+
+                    // the view pins the values in place
+                    TEST_CHECK_THROWS(ParameterViewError, p.declare("test::declared-with-view", 1.0));
+                    TEST_CHECK_EQUAL(p.has("test::declared-with-view"), false);
+
+                    // existing parameters can still be declared
+                    TEST_CHECK_EQUAL(p.declare("mass::c").id(), m_c.id());
+
+                    // clones are not affected by the view
+                    Parameters clone = p.clone();
+                    const auto clone_generation = clone.generation();
+                    TEST_CHECK_EQUAL(clone.generation(), clone_generation);
+                    clone.declare("test::declared-in-clone", 1.0);
+                }
+
+                // all parameters are marked as changed once the last view is gone
+                TEST_CHECK(p.generation() > generation);
+                TEST_CHECK_EQUAL(m_c.generation(), p.generation());
+                TEST_CHECK_EQUAL(user.changed_since(p, generation), true);
+                TEST_CHECK_EQUAL(user.changed_since(p, p.generation()), false);
+
+                p.declare("test::declared-without-view", 1.0);
+                TEST_CHECK_EQUAL(p.has("test::declared-without-view"), true);
+            }
+
+            // Shared objects
+            {
+                Parameters p = Parameters::Defaults();
+                unsigned constructions = 0;
+                auto factory = [&constructions] () -> std::shared_ptr<void>
+                {
+                    ++constructions;
+                    return std::make_shared<double>(1.0);
+                };
+
+                auto a = p.shared_object(typeid(double), "a", factory);
+                auto b = p.shared_object(typeid(double), "a", factory);
+                auto c = p.shared_object(typeid(double), "c", factory);
+                auto d = p.shared_object(typeid(int),    "a", factory);
+                TEST_CHECK_EQUAL(a.get(), b.get());
+                TEST_CHECK(a.get() != c.get());
+                TEST_CHECK(a.get() != d.get());
+                TEST_CHECK_EQUAL(constructions, 3u);
+
+                // clones do not share objects with the original
+                Parameters clone = p.clone();
+                auto e = clone.shared_object(typeid(double), "a", factory);
+                TEST_CHECK(a.get() != e.get());
+                TEST_CHECK_EQUAL(constructions, 4u);
+
+                // shared objects are not kept alive by the parameters
+                a.reset();
+                b.reset();
+                auto f = p.shared_object(typeid(double), "a", factory);
+                TEST_CHECK_EQUAL(constructions, 5u);
+            }
+
             // Parameters::has
             {
                 Parameters p = Parameters::Defaults();
@@ -21,17 +21,37 @@
 #include <eos/utils/destringify.hh>
 #include <eos/utils/instantiation_policy-impl.hh>
 #include <eos/utils/lock.hh>
+#include <eos/utils/log.hh>
 #include <eos/utils/mutex.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
 #include <eos/utils/thread.hh>
 #include <eos/utils/thread_pool.hh>
 
+#include <atomic>
+#include <deque>
 #include <list>
+#include <memory>
+#include <vector>
 
 #include <unistd.h>
 
 namespace eos
 {
+    namespace impl
+    {
+        // A worker's double-ended queue of tasks
+        struct TaskQueue
+        {
+            Mutex mutex;
+
+            std::deque<Task> tasks;
+        };
+
+        // The pool and worker index of the calling thread, if it is a worker thread
+        thread_local const Implementation<ThreadPool> * current_pool = nullptr;
+        thread_local unsigned current_worker = 0;
+    }
+
     template <>
     struct Implementation<ThreadPool>
     {
@@ -40,72 +60,158 @@ namespace eos
         unsigned long stop_capacity;
 
         // Thread termination
-        Mutex * const terminate_mutex;
-
         bool terminate;
 
         // Job handling
-        Mutex * const job_mutex;
+        std::vector<std::unique_ptr<impl::TaskQueue>> queues;
+
+        // Number of tasks in all queues
+        std::atomic<unsigned long> queued_jobs;
+
+        // Number of tasks that have been scheduled, but not yet completed
+        std::atomic<unsigned long> pending_jobs;
 
-        ConditionVariable * const job_arrival;
-        ConditionVariable * const job_capacity;
+        // Round-robin counter to distribute tasks scheduled from outside the pool
+        std::atomic<unsigned> next_queue;
 
-        unsigned long waiting_for_jobs;
-        unsigned long pending_jobs;
+        // Idle workers
+        Mutex idle_mutex;
+        ConditionVariable job_arrival;
+        std::atomic<unsigned> waiting_for_jobs;
 
-        std::list<std::pair<Ticket, std::function<void (void)> *>> queue;
+        // Capacity handling
+        Mutex capacity_mutex;
+        ConditionVariable job_capacity;
 
         std::list<Thread *> threads;
 
-        void thread_function()
+        void push(Task && task)
         {
-            std::function<void (void)> * job;
-            Ticket ticket;
+            const unsigned idx = (impl::current_pool == this) ? impl::current_worker : (next_queue++ % number_of_threads);
 
-            do
+            pending_jobs += 1;
+            queued_jobs += 1;
+
+            {
+                Lock l(queues[idx]->mutex);
+                queues[idx]->tasks.push_back(std::move(task));
+            }
+
+            if (waiting_for_jobs > 0)
+            {
+                Lock l(idle_mutex);
+                job_arrival.signal();
+            }
+        }
+
+        bool pop(Task & task)
+        {
+            if (0 == queued_jobs)
+                return false;
+
+            // workers prefer the most recent task in their own queue
+            const bool is_worker = (impl::current_pool == this);
+            const unsigned start = is_worker ? impl::current_worker : (next_queue % number_of_threads);
+            if (is_worker)
             {
+                auto & q = *queues[start];
+                Lock l(q.mutex);
+                if (! q.tasks.empty())
                 {
-                    Lock l(*terminate_mutex);
-                    if (terminate)
-                        break;
+                    task = std::move(q.tasks.back());
+                    q.tasks.pop_back();
+                    queued_jobs -= 1;
+
+                    return true;
                 }
+            }
+
+            // steal the oldest task from any other queue
+            for (unsigned i = 0 ; i < number_of_threads ; ++i)
+            {
+                auto & q = *queues[(start + i) % number_of_threads];
+                Lock l(q.mutex);
+                if (q.tasks.empty())
+                    continue;
+
+                task = std::move(q.tasks.front());
+                q.tasks.pop_front();
+                queued_jobs -= 1;
+
+                return true;
+            }
+
+            return false;
+        }
+
+        void run(Task & task)
+        {
+            TaskGroup * group = task.group();
+            std::exception_ptr exception;
+
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+                exception = std::current_exception();
+            }
+
+            // release the callable's resources before signalling completion
+            task = Task();
 
-                job = 0;
+            if (pending_jobs-- == nominal_capacity + 1)
+            {
+                Lock l(capacity_mutex);
+                job_capacity.broadcast();
+            }
 
+            if (group)
+            {
+                group->_finished(exception);
+            }
+            else if (exception)
+            {
+                try
                 {
-                    Lock l(*job_mutex);
-
-                    if (queue.empty())
-                    {
-                        waiting_for_jobs += 1;
-                        job_arrival->wait(*job_mutex);
-                        waiting_for_jobs -= 1;
-                    }
-
-                    if (queue.empty())
-                    {
-                        Lock l(*terminate_mutex);
-                        if (terminate)
-                            break;
-                        else
-                            continue;
-                    }
-
-                    ticket = queue.front().first;
-                    job = queue.front().second;
-                    queue.pop_front();
+                    std::rethrow_exception(exception);
                 }
-
-                (*job)();
+                catch (std::exception & e)
                 {
-                    Lock l(*job_mutex);
-                    pending_jobs -= 1;
+                    Log::instance()->message("ThreadPool", ll_error)
+                        << "Uncaught exception in asynchronous job: " << e.what();
+                }
+                catch (...)
+                {
+                    Log::instance()->message("ThreadPool", ll_error)
+                        << "Uncaught exception in asynchronous job";
+                }
+            }
+        }
 
-                    if (pending_jobs == nominal_capacity)
-                        job_capacity->signal();
+        void thread_function(unsigned index)
+        {
+            impl::current_pool = this;
+            impl::current_worker = index;
 
+            do
+            {
+                Task task;
+                if (pop(task))
+                {
+                    run(task);
+                    continue;
                 }
-                ticket.mark();
+
+                Lock l(idle_mutex);
+                if (terminate)
+                    break;
+
+                waiting_for_jobs += 1;
+                if (0 == queued_jobs)
+                    job_arrival.wait(idle_mutex);
+                waiting_for_jobs -= 1;
             }
             while (true);
         }
@@ -123,37 +229,37 @@ namespace eos
                 result = std::min(result, max_threads);
             }
 
-            return result;
+            // we need at least one worker
+            return std::max(result, 1u);
         }
 
         Implementation() :
             number_of_threads(_number_of_threads()),
             nominal_capacity(number_of_threads * 10),
             stop_capacity(nominal_capacity * 2),
-            terminate_mutex(new Mutex),
             terminate(false),
-            job_mutex(new Mutex),
-            job_arrival(new ConditionVariable),
-            job_capacity(new ConditionVariable),
-            waiting_for_jobs(0),
-            pending_jobs(0)
+            queued_jobs(0),
+            pending_jobs(0),
+            next_queue(0),
+            waiting_for_jobs(0)
         {
             for (unsigned i(0) ; i < number_of_threads ; ++i)
             {
-                threads.push_back(new Thread(std::bind(&Implementation<ThreadPool>::thread_function, this)));
+                queues.push_back(std::make_unique<impl::TaskQueue>());
+            }
+
+            for (unsigned i(0) ; i < number_of_threads ; ++i)
+            {
+                threads.push_back(new Thread(std::bind(&Implementation<ThreadPool>::thread_function, this, i)));
             }
         }
 
         ~Implementation()
         {
             {
-                Lock l(*terminate_mutex);
+                Lock l(idle_mutex);
                 terminate = true;
-            }
-
-            {
-                Lock l(*job_mutex);
-                job_arrival->broadcast();
+                job_arrival.broadcast();
             }
 
             for (auto & thread : threads)
@@ -176,18 +282,28 @@ namespace eos
     Ticket
     ThreadPool::enqueue(const std::function<void (void)> & job)
     {
-        std::pair<Ticket, std::function<void (void)> *> item(Ticket(), new std::function<void (void)>(job));
+        Ticket ticket;
 
-        {
-            Lock l(*_imp->job_mutex);
-            _imp->queue.push_back(item);
-            _imp->pending_jobs += 1;
+        _imp->push(Task([job, ticket] () mutable {
+            try
+            {
+                job();
+            }
+            catch (...)
+            {
+                ticket.mark();
+                throw;
+            }
+            ticket.mark();
+        }));
 
-            if (_imp->waiting_for_jobs > 0)
-                _imp->job_arrival->signal();
-        }
+        return ticket;
+    }
 
-        return item.first;
+    void
+    ThreadPool::schedule(Task && task)
+    {
+        _imp->push(std::move(task));
     }
 
     ThreadPool *
@@ -199,12 +315,22 @@ namespace eos
     void
     ThreadPool::wait_for_free_capacity()
     {
-        Lock l(*_imp->job_mutex);
+        while (_imp->pending_jobs >= _imp->stop_capacity)
+        {
+            // help to reduce the number of pending jobs
+            Task task;
+            if (_imp->pop(task))
+            {
+                _imp->run(task);
+                continue;
+            }
 
-        if (_imp->pending_jobs < _imp->stop_capacity)
-            return;
+            Lock l(_imp->capacity_mutex);
+            if (_imp->pending_jobs > _imp->nominal_capacity)
+                _imp->job_capacity.wait(_imp->capacity_mutex);
 
-        _imp->job_capacity->wait(*_imp->job_mutex);
+            return;
+        }
     }
 
     unsigned
@@ -212,4 +338,115 @@ namespace eos
     {
         return _imp->number_of_threads;
     }
+
+    template <>
+    struct Implementation<TaskGroup>
+    {
+        // Number of scheduled, but not yet completed tasks
+        std::atomic<unsigned long> outstanding;
+
+        Mutex mutex;
+
+        ConditionVariable completion;
+
+        // Set by the last task to complete; guarded by the mutex
+        bool done;
+
+        // First exception thrown by any task; guarded by the mutex
+        std::exception_ptr exception;
+
+        Implementation() :
+            outstanding(0),
+            done(true)
+        {
+        }
+    };
+
+    TaskGroup::TaskGroup() :
+        PrivateImplementationPattern<TaskGroup>(new Implementation<TaskGroup>)
+    {
+    }
+
+    TaskGroup::~TaskGroup()
+    {
+        try
+        {
+            wait();
+        }
+        catch (...)
+        {
+            // exceptions have been discarded
+        }
+    }
+
+    void
+    TaskGroup::_started()
+    {
+        if (0 == _imp->outstanding++)
+        {
+            Lock l(_imp->mutex);
+            _imp->done = false;
+        }
+    }
+
+    void
+    TaskGroup::_finished(const std::exception_ptr & exception)
+    {
+        if (exception)
+        {
+            Lock l(_imp->mutex);
+            if (! _imp->exception)
+                _imp->exception = exception;
+        }
+
+        if (1 != _imp->outstanding--)
+            return;
+
+        // the group's owner might only return from wait() once we release the mutex
+        Lock l(_imp->mutex);
+        if (0 == _imp->outstanding)
+        {
+            _imp->done = true;
+            _imp->completion.broadcast();
+        }
+    }
+
+    void
+    TaskGroup::wait()
+    {
+        auto pool = ThreadPool::instance()->_imp;
+
+        do
+        {
+            // help to execute queued tasks while our own tasks are still outstanding
+            if (0 != _imp->outstanding)
+            {
+                Task task;
+                if (pool->pop(task))
+                {
+                    pool->run(task);
+                    continue;
+                }
+            }
+
+            Lock l(_imp->mutex);
+            if (_imp->done)
+                break;
+
+            if (0 != pool->queued_jobs)
+                continue;
+
+            _imp->completion.wait(_imp->mutex);
+        }
+        while (true);
+
+        std::exception_ptr exception;
+        {
+            Lock l(_imp->mutex);
+            std::swap(exception, _imp->exception);
+        }
+
+        if (exception)
+            std::rethrow_exception(exception);
+    }
 }
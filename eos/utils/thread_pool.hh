@@ -24,27 +24,259 @@
 #include <eos/utils/private_implementation_pattern.hh>
 #include <eos/utils/ticket.hh>
 
+#include <cstddef>
+#include <exception>
 #include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 namespace eos
 {
+    class TaskGroup;
+
+    /*!
+     * Task is a move-only, type-erased wrapper around a callable without arguments.
+     *
+     * Callables of up to Task::buffer_size bytes are stored inline, so that
+     * scheduling a Task does not require a heap allocation. Larger callables
+     * are moved to the heap.
+     */
+    class Task
+    {
+        public:
+            static constexpr std::size_t buffer_size = 64;
+
+        private:
+            alignas(std::max_align_t) unsigned char _buffer[buffer_size];
+
+            void (*_invoke)(void *);
+
+            void (*_relocate)(void * from, void * to);
+
+            void (*_destroy)(void *);
+
+            TaskGroup * _group;
+
+            template <typename F_> static constexpr bool is_inline = (sizeof(F_) <= buffer_size) && (alignof(F_) <= alignof(std::max_align_t))
+                && std::is_nothrow_move_constructible<F_>::value;
+
+            template <typename F_> static void _invoke_inline(void * p) { (*static_cast<F_ *>(p))(); }
+            template <typename F_> static void _relocate_inline(void * from, void * to) { new (to) F_(std::move(*static_cast<F_ *>(from))); static_cast<F_ *>(from)->~F_(); }
+            template <typename F_> static void _destroy_inline(void * p) { static_cast<F_ *>(p)->~F_(); }
+
+            template <typename F_> static void _invoke_heap(void * p) { (**static_cast<F_ **>(p))(); }
+            template <typename F_> static void _relocate_heap(void * from, void * to) { *static_cast<F_ **>(to) = *static_cast<F_ **>(from); }
+            template <typename F_> static void _destroy_heap(void * p) { delete *static_cast<F_ **>(p); }
+
+        public:
+            ///@name Basic Functions
+            ///@{
+            /// Constructor of an empty Task.
+            Task() :
+                _invoke(nullptr),
+                _relocate(nullptr),
+                _destroy(nullptr),
+                _group(nullptr)
+            {
+            }
+
+            /*!
+             * Constructor.
+             *
+             * @param f     The callable that shall be executed.
+             * @param group The (optional) TaskGroup that tracks the completion of this Task.
+             */
+            template <typename F_, typename = typename std::enable_if<! std::is_same<typename std::decay<F_>::type, Task>::value>::type>
+            Task(F_ && f, TaskGroup * group = nullptr) :
+                _group(group)
+            {
+                using F = typename std::decay<F_>::type;
+
+                if constexpr (is_inline<F>)
+                {
+                    new (_buffer) F(std::forward<F_>(f));
+                    _invoke   = &_invoke_inline<F>;
+                    _relocate = &_relocate_inline<F>;
+                    _destroy  = &_destroy_inline<F>;
+                }
+                else
+                {
+                    *reinterpret_cast<F **>(_buffer) = new F(std::forward<F_>(f));
+                    _invoke   = &_invoke_heap<F>;
+                    _relocate = &_relocate_heap<F>;
+                    _destroy  = &_destroy_heap<F>;
+                }
+            }
+
+            /// Move constructor.
+            Task(Task && other) noexcept :
+                _invoke(other._invoke),
+                _relocate(other._relocate),
+                _destroy(other._destroy),
+                _group(other._group)
+            {
+                if (_invoke)
+                    _relocate(other._buffer, _buffer);
+
+                other._invoke = nullptr;
+                other._group = nullptr;
+            }
+
+            /// Move assignment.
+            Task & operator= (Task && other) noexcept
+            {
+                if (this != &other)
+                {
+                    if (_invoke)
+                        _destroy(_buffer);
+
+                    _invoke   = other._invoke;
+                    _relocate = other._relocate;
+                    _destroy  = other._destroy;
+                    _group    = other._group;
+
+                    if (_invoke)
+                        _relocate(other._buffer, _buffer);
+
+                    other._invoke = nullptr;
+                    other._group = nullptr;
+                }
+
+                return *this;
+            }
+
+            Task(const Task &) = delete;
+            Task & operator= (const Task &) = delete;
+
+            /// Destructor.
+            ~Task()
+            {
+                if (_invoke)
+                    _destroy(_buffer);
+
+                _invoke = nullptr;
+            }
+            ///@}
+
+            /// Return whether this Task wraps a callable.
+            explicit operator bool () const
+            {
+                return nullptr != _invoke;
+            }
+
+            /// Return the TaskGroup that tracks the completion of this Task.
+            TaskGroup * group() const
+            {
+                return _group;
+            }
+
+            /// Execute the wrapped callable.
+            void operator() ()
+            {
+                _invoke(_buffer);
+            }
+    };
+
+    /*!
+     * ThreadPool keeps a fixed number of worker threads, and schedules Tasks onto them.
+     *
+     * Each worker owns a double-ended queue of Tasks. Tasks that are scheduled from a worker
+     * are pushed onto and popped from the back of that worker's queue. Idle workers steal
+     * Tasks from the front of other workers' queues. Threads that wait for the completion
+     * of a TaskGroup help to execute queued Tasks in the meantime.
+     *
+     * The number of workers defaults to the number of configured processors, and can be
+     * limited via the environment variable EOS_MAX_THREADS.
+     */
     class ThreadPool :
         public InstantiationPolicy<ThreadPool, Singleton>,
         public PrivateImplementationPattern<ThreadPool>
     {
         public:
+            friend class TaskGroup;
+
             ThreadPool();
 
             ~ThreadPool();
 
+            /*!
+             * Enqueue a function for asynchronous execution.
+             *
+             * @param work The function that shall be executed.
+             *
+             * Returns a Ticket that is marked as soon as the function has been executed.
+             */
             Ticket enqueue(const std::function<void (void)> & work);
 
+            /*!
+             * Schedule a Task for asynchronous execution.
+             *
+             * @param task The Task that shall be executed.
+             */
+            void schedule(Task && task);
+
             static ThreadPool * instance();
 
+            /*!
+             * Block the calling thread while the number of pending jobs exceeds the pool's capacity.
+             *
+             * The calling thread helps to execute pending jobs in the meantime.
+             */
             void wait_for_free_capacity();
 
             unsigned number_of_threads() const;
     };
+
+    /*!
+     * TaskGroup tracks the completion of a set of Tasks that are run on the ThreadPool.
+     *
+     * Waiting for a TaskGroup does not block the calling thread idly. Instead, it helps
+     * to execute queued Tasks until all Tasks in the group have completed. It is therefore
+     * safe to wait for a TaskGroup from within a Task.
+     */
+    class TaskGroup :
+        public InstantiationPolicy<TaskGroup, NonCopyable>,
+        public PrivateImplementationPattern<TaskGroup>
+    {
+        private:
+            /// Record that a Task of this group has been scheduled.
+            void _started();
+
+            /// Record that a Task of this group has completed, possibly by throwing an exception.
+            void _finished(const std::exception_ptr & exception);
+
+        public:
+            friend struct Implementation<ThreadPool>;
+
+            ///@name Basic Functions
+            ///@{
+            /// Constructor.
+            TaskGroup();
+
+            /// Destructor. Waits for all outstanding Tasks, but discards their exceptions.
+            ~TaskGroup();
+            ///@}
+
+            /*!
+             * Run a callable as part of this group.
+             *
+             * @param f The callable that shall be executed.
+             */
+            template <typename F_>
+            void run(F_ && f)
+            {
+                _started();
+                ThreadPool::instance()->schedule(Task(std::forward<F_>(f), this));
+            }
+
+            /*!
+             * Wait for the completion of all Tasks in this group.
+             *
+             * Rethrows the first exception thrown by any of the group's Tasks.
+             */
+            void wait();
+    };
 }
 
 #endif
@@ -0,0 +1,122 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2021 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <test/test.hh>
+#include <eos/utils/exception.hh>
+#include <eos/utils/thread_pool.hh>
+
+#include <array>
+#include <atomic>
+#include <vector>
+
+using namespace test;
+using namespace eos;
+
+class ThreadPoolTest :
+    public TestCase
+{
+    public:
+        ThreadPoolTest() :
+            TestCase("thread_pool_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            // Tasks store small callables inline and large callables on the heap
+            {
+                int counter = 0;
+
+                Task small([&counter] () { counter += 1; });
+                small();
+                TEST_CHECK_EQUAL(counter, 1);
+
+                std::array<double, 32> payload{};
+                payload[31] = 2.0;
+                Task large([&counter, payload] () { counter += int(payload[31]); });
+                Task moved(std::move(large));
+                TEST_CHECK(! large);
+                moved();
+                TEST_CHECK_EQUAL(counter, 3);
+            }
+
+            // enqueue and tickets
+            {
+                std::atomic<unsigned> counter(0);
+                std::vector<Ticket> tickets;
+
+                for (unsigned i = 0 ; i < 100 ; ++i)
+                {
+                    tickets.push_back(ThreadPool::instance()->enqueue([&counter] () { counter += 1; }));
+                }
+
+                for (auto & ticket : tickets)
+                {
+                    ticket.wait();
+                }
+
+                TEST_CHECK_EQUAL(counter, 100u);
+            }
+
+            // task groups, including nested groups
+            {
+                std::atomic<unsigned> counter(0);
+                TaskGroup outer;
+
+                for (unsigned i = 0 ; i < 20 ; ++i)
+                {
+                    outer.run([&counter] () {
+                        TaskGroup inner;
+                        for (unsigned j = 0 ; j < 20 ; ++j)
+                        {
+                            inner.run([&counter] () { counter += 1; });
+                        }
+                        inner.wait();
+                    });
+                }
+
+                outer.wait();
+                TEST_CHECK_EQUAL(counter, 400u);
+
+                // waiting again on a completed group returns immediately
+                outer.wait();
+            }
+
+            // exceptions are propagated to the waiting thread
+            {
+                std::atomic<unsigned> counter(0);
+                TaskGroup group;
+
+                for (unsigned i = 0 ; i < 10 ; ++i)
+                {
+                    group.run([&counter, i] () {
+                        counter += 1;
+                        if (5 == i)
+                            throw InternalError("thread_pool_test");
+                    });
+                }
+
+                TEST_CHECK_THROWS(InternalError, group.wait());
+                TEST_CHECK_EQUAL(counter, 10u);
+
+                // the exception has been consumed
+                TEST_CHECK_NO_THROW(group.wait());
+            }
+        }
+} thread_pool_test;
@@ -34,8 +34,6 @@ namespace eos
         private:
             Id _id;
 
-            Unit(const Id & id) : _id(id) {}
-
         public:
             enum class Id :
                 int
@@ -55,12 +53,15 @@ namespace eos
             };
 
             Unit(const std::string &);
+            explicit Unit(const Id & id) : _id(id) {}
             Unit(const Unit &) = default;
             Unit(Unit &&) = default;
             ~Unit() = default;
 
             const std::string & latex() const;
 
+            Id id() const { return _id; }
+
             static Unit Undefined();
             static Unit None();
             static Unit GeV();
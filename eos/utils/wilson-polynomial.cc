@@ -21,7 +21,11 @@
 #include <eos/utils/stringify.hh>
 #include <eos/utils/wilson-polynomial.hh>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <limits>
+#include <vector>
 
 namespace eos
 {
@@ -292,6 +296,133 @@ namespace eos
             }
     };
 
+    class WilsonPolynomialSurrogate :
+        public Observable
+    {
+        private:
+            QualifiedName _name;
+
+            Parameters _parameters;
+
+            Kinematics _kinematics;
+
+            Options _options;
+
+            // Private clone of the observable, from which the polynomial is constructed
+            ObservablePtr _observable;
+
+            mutable Kinematics _private_kinematics;
+
+            // Names of the coefficients that the observable uses
+            std::list<std::string> _coefficients;
+
+            // All other parameters that the observable uses, and their counterparts in the private clone
+            std::vector<Parameter> _nuisances;
+
+            mutable std::vector<Parameter> _private_nuisances;
+
+            // Values of the nuisance parameters and the kinematic variables as of the last construction of the polynomial
+            mutable std::vector<double> _values;
+
+            // The polynomial, in terms of our Parameters object
+            mutable WilsonPolynomial _polynomial;
+
+            // Synchronize the private clone with the nuisance parameters and the kinematics; returns true if any value changed
+            bool _synchronize() const
+            {
+                bool changed = false;
+
+                unsigned k = 0;
+                for (unsigned i = 0 ; i < _nuisances.size() ; ++i, ++k)
+                {
+                    // NaN values never compare equal, and are therefore always considered changed
+                    const double value = _nuisances[i].evaluate();
+                    if (value == _values[k])
+                        continue;
+
+                    changed = true;
+                    _values[k] = value;
+                    _private_nuisances[i].set(value);
+                }
+
+                for (const auto & v : _kinematics)
+                {
+                    const double value = v.evaluate();
+                    if (value != _values[k])
+                    {
+                        changed = true;
+                        _values[k] = value;
+                        _private_kinematics.set(v.name(), value);
+                    }
+                    ++k;
+                }
+
+                return changed;
+            }
+
+        public:
+            WilsonPolynomialSurrogate(const ObservablePtr & observable, const std::list<std::string> & coefficients) :
+                _name(observable->name()),
+                _parameters(observable->parameters()),
+                _kinematics(observable->kinematics()),
+                _options(observable->options()),
+                _observable(observable->clone(_parameters.clone())),
+                _private_kinematics(_observable->kinematics()),
+                _polynomial(Constant(0.0))
+            {
+                ParameterUser::uses(*observable);
+                ReferenceUser::uses(*observable);
+
+                Parameters private_parameters = _observable->parameters();
+                for (const auto & id : *observable)
+                {
+                    Parameter p = _parameters[id];
+                    if (coefficients.cend() != std::find(coefficients.cbegin(), coefficients.cend(), p.name()))
+                    {
+                        _coefficients.push_back(p.name());
+                    }
+                    else
+                    {
+                        _nuisances.push_back(p);
+                        _private_nuisances.push_back(private_parameters[id]);
+                    }
+                }
+
+                // the polynomial is constructed on first evaluation
+                _values.resize(_nuisances.size() + std::distance(_kinematics.begin(), _kinematics.end()), std::numeric_limits<double>::quiet_NaN());
+            }
+
+            ~WilsonPolynomialSurrogate()
+            {
+            }
+
+            const std::list<std::string> & coefficients() const { return _coefficients; }
+
+            virtual const QualifiedName & name() const { return _name; }
+            virtual Kinematics kinematics() { return _kinematics; }
+            virtual Parameters parameters() { return _parameters; }
+            virtual Options options() { return _options; }
+            virtual ObservablePtr clone() const { return clone(_parameters.clone()); }
+
+            virtual double evaluate() const
+            {
+                if (_synchronize())
+                {
+                    WilsonPolynomialCloner cloner(_parameters);
+                    _polynomial = make_polynomial(_observable, _coefficients).accept_returning<WilsonPolynomial>(cloner);
+                }
+
+                WilsonPolynomialEvaluator evaluator;
+
+                return _polynomial.accept_returning<double>(evaluator);
+            }
+
+            virtual ObservablePtr clone(const Parameters & parameters) const
+            {
+                return ObservablePtr(new WilsonPolynomialSurrogate(_observable->clone(parameters), _coefficients));
+            }
+    };
+
     ObservablePtr
     make_polynomial_observable(const WilsonPolynomial & polynomial, const Parameters & parameters)
     {
@@ -311,6 +442,63 @@ namespace eos
         return ObservablePtr(new WilsonPolynomialHTLikeRatio(numerator, denominator1, denominator2, parameters));
     }
 
+    ObservablePtr
+    make_polynomial_surrogate(const ObservablePtr & observable, const std::list<std::string> & coefficients, const double & tolerance)
+    {
+        // we cannot track the nuisance parameters of observables that do not declare their parameters
+        if (observable->begin() == observable->end())
+            return { nullptr };
+
+        // validate on an independent clone, leaving the observable's parameters untouched
+        Parameters parameters = observable->parameters().clone();
+        ObservablePtr direct = observable->clone(parameters);
+        WilsonPolynomialSurrogate surrogate(direct, coefficients);
+
+        if (surrogate.coefficients().empty())
+            return { nullptr };
+
+        static const unsigned test_points = 4;
+        std::array<double, test_points> direct_values, surrogate_values;
+        try
+        {
+            for (unsigned i = 0 ; i < test_points ; ++i)
+            {
+                // the first test point is the current point; all others are pseudo-random and differ
+                // from the points used in the construction of the polynomial
+                unsigned j = 0;
+                for (const auto & coefficient : surrogate.coefficients())
+                {
+                    if (i > 0)
+                        parameters[coefficient] = 2.5 * std::sin(1.0 + 3.0 * i + 1.7 * j);
+
+                    ++j;
+                }
+
+                direct_values[i]    = direct->evaluate();
+                surrogate_values[i] = surrogate.evaluate();
+            }
+        }
+        catch (eos::Exception &)
+        {
+            return { nullptr };
+        }
+
+        double scale = 0.0;
+        for (const auto & value : direct_values)
+        {
+            scale = std::max(scale, std::abs(value));
+        }
+
+        for (unsigned i = 0 ; i < test_points ; ++i)
+        {
+            // NaN values fail the comparison
+            if (! (std::abs(surrogate_values[i] - direct_values[i]) <= tolerance * scale))
+                return { nullptr };
+        }
+
+        return ObservablePtr(new WilsonPolynomialSurrogate(observable, coefficients));
+    }
+
     /* WilsonPolynomialCloner */
     WilsonPolynomialCloner::WilsonPolynomialCloner(const Parameters & parameters) :
         _parameters(parameters)
@@ -73,6 +73,25 @@ namespace eos
     ObservablePtr make_polynomial_ht_like_ratio(const WilsonPolynomial & numerator, const WilsonPolynomial & denominator,
             const WilsonPolynomial & denominator2, const Parameters & parameters);
 
+    /*!
+     * Return an Observable that replaces the evaluation of a given observable by a
+     * WilsonPolynomial in those of the given coefficients that the observable uses.
+     *
+     * The polynomial is constructed from a private clone of the observable, at the current
+     * values of all other parameters and kinematic variables. It is reconstructed whenever
+     * any of these values changes.
+     *
+     * A null pointer is returned if the observable does not declare its parameters, if it
+     * does not use any of the coefficients, or if the polynomial fails to reproduce the
+     * observable at a set of test points within the given relative tolerance.
+     *
+     * @param observable   The observable that shall be replaced.
+     * @param coefficients The names of the coefficients.
+     * @param tolerance    The relative tolerance for the comparison at the test points.
+     */
+    ObservablePtr make_polynomial_surrogate(const ObservablePtr & observable, const std::list<std::string> & coefficients,
+            const double & tolerance = 1.0e-8);
+
     class WilsonPolynomialCloner
     {
         private:
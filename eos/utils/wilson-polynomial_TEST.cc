@@ -180,3 +180,117 @@ class WilsonPolynomialClonerTest :
             TEST_CHECK_EQUAL(p.accept_returning<double>(evaluator), c.accept_returning<double>(evaluator));
         }
 } wilson_polynomial_cloner_test;
+
+struct WilsonPolynomialSurrogateTestObservable :
+    public Observable
+{
+    QualifiedName n;
+    Parameters p;
+    Kinematics k;
+    Options o;
+    Parameter re_c9;
+    Parameter re_c10;
+    Parameter m_b;
+    KinematicVariable q2;
+
+    WilsonPolynomialSurrogateTestObservable(const Parameters & p, const Kinematics & k, const Options & o) :
+        n("WilsonPolynomial::SurrogateTestObservable"),
+        p(p),
+        k(k),
+        o(o),
+        re_c9(p["b->smumu::Re{c9}"]),
+        re_c10(p["b->smumu::Re{c10}"]),
+        m_b(p["mass::b(MSbar)"]),
+        q2(this->k["q2"])
+    {
+        uses(re_c9.id());
+        uses(re_c10.id());
+        uses(m_b.id());
+    }
+
+    virtual const QualifiedName & name() const { return n; }
+    virtual Parameters parameters() { return p; }
+    virtual Kinematics kinematics() { return k; }
+    virtual Options options() { return o; }
+    virtual ObservablePtr clone() const { return ObservablePtr(new WilsonPolynomialSurrogateTestObservable(p.clone(), k.clone(), o)); }
+    virtual ObservablePtr clone(const Parameters & p) const { return ObservablePtr(new WilsonPolynomialSurrogateTestObservable(p, k.clone(), o)); }
+
+    virtual double evaluate() const
+    {
+        // quadratic in the Wilson coefficients by default, and a ratio otherwise
+        const double numerator = m_b * m_b * q2 * (0.4 + re_c9 * re_c9 + 0.7 * re_c9 * re_c10 + 1.3 * re_c10 * re_c10 - 0.2 * re_c10);
+
+        if ("ratio" == o.get("form", "polynomial"))
+            return numerator / (1.0 + re_c9 * re_c9);
+
+        return numerator;
+    }
+};
+
+class WilsonPolynomialSurrogateTest :
+    public TestCase
+{
+    public:
+        WilsonPolynomialSurrogateTest() :
+            TestCase("wilson_polynomial_surrogate_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            static const double eps = 1e-10;
+
+            static const std::list<std::string> coefficients{ "b->smumu::Re{c9}", "b->smumu::Re{c10}", "b->smumu::Re{c9'}" };
+
+            // eligible observable
+            {
+                Parameters parameters = Parameters::Defaults();
+                Kinematics kinematics{ { "q2", 1.0 } };
+                ObservablePtr o = ObservablePtr(new WilsonPolynomialSurrogateTestObservable(parameters, kinematics, Options()));
+                ObservablePtr s = make_polynomial_surrogate(o, coefficients);
+
+                TEST_CHECK(bool(s));
+                TEST_CHECK_EQUAL(s->name(), o->name());
+                TEST_CHECK(s->kinematics() == o->kinematics());
+                TEST_CHECK_EQUAL(std::distance(s->begin(), s->end()), 3);
+
+                parameters["b->smumu::Re{c9}"]  = +1.7;
+                parameters["b->smumu::Re{c10}"] = -3.1;
+                TEST_CHECK_NEARLY_EQUAL(s->evaluate(), o->evaluate(), eps);
+
+                // changes of nuisance parameters and kinematic variables trigger a new polynomial
+                parameters["mass::b(MSbar)"] = 4.5;
+                TEST_CHECK_NEARLY_EQUAL(s->evaluate(), o->evaluate(), eps);
+
+                kinematics.set("q2", 3.0);
+                TEST_CHECK_NEARLY_EQUAL(s->evaluate(), o->evaluate(), eps);
+
+                // clones are independent
+                Parameters clone_parameters = parameters.clone();
+                ObservablePtr c = s->clone(clone_parameters);
+                clone_parameters["b->smumu::Re{c9}"] = -0.5;
+                TEST_CHECK_NEARLY_EQUAL(c->evaluate(), o->clone(clone_parameters)->evaluate(), eps);
+                TEST_CHECK_NEARLY_EQUAL(s->evaluate(), o->evaluate(), eps);
+            }
+
+            // ineligible observable
+            {
+                Parameters parameters = Parameters::Defaults();
+                Kinematics kinematics{ { "q2", 1.0 } };
+                ObservablePtr o = ObservablePtr(new WilsonPolynomialSurrogateTestObservable(parameters, kinematics, Options{ { "form", "ratio" } }));
+
+                TEST_CHECK(! make_polynomial_surrogate(o, coefficients));
+            }
+
+            // observables that do not use the coefficients, or that do not declare their parameters
+            {
+                Parameters parameters = Parameters::Defaults();
+                Kinematics kinematics{ { "q2", 1.0 } };
+                ObservablePtr o = ObservablePtr(new WilsonPolynomialSurrogateTestObservable(parameters, kinematics, Options()));
+                ObservablePtr t = ObservablePtr(new WilsonPolynomialTestObservable(parameters, kinematics, Options()));
+
+                TEST_CHECK(! make_polynomial_surrogate(o, std::list<std::string>{ "b->s::Re{c7}" }));
+                TEST_CHECK(! make_polynomial_surrogate(t, coefficients));
+            }
+        }
+} wilson_polynomial_surrogate_test;
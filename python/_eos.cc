@@ -27,15 +27,19 @@
 #include "eos/models/model.hh"
 #include "eos/utils/kinematic.hh"
 #include "eos/utils/log.hh"
+#include "eos/utils/memoise.hh"
 #include "eos/utils/parameters.hh"
 #include "eos/utils/options.hh"
 #include "eos/utils/qualified-name.hh"
 #include "eos/utils/reference-name.hh"
 #include "eos/utils/units.hh"
 #include "eos/statistics/goodness-of-fit.hh"
+#include "eos/statistics/laplace-approximation.hh"
 #include "eos/statistics/log-likelihood.hh"
 #include "eos/statistics/log-posterior.hh"
 #include "eos/statistics/log-prior.hh"
+#include "eos/statistics/markov-chain-sampler.hh"
+#include "eos/statistics/profile-likelihood-scan.hh"
 #include "eos/statistics/test-statistic-impl.hh"
 
 #include "eos/rare-b-decays/charm-loops-impl.hh"
@@ -215,6 +219,345 @@ namespace impl
 
     // wrapper to avoid issues with virtual inheritance and overloading
     double m_b_pole_wrapper_noargs(Model& m) { return m.m_b_pole(); }
+
+    // wrapper for MemoisationControl::statistics, returning a dict of dicts keyed by the function names
+    dict
+    memoisation_statistics()
+    {
+        dict result;
+        for (const auto & s : MemoisationControl::instance()->statistics())
+        {
+            dict entry;
+            entry["hits"]      = s.hits;
+            entry["misses"]    = s.misses;
+            entry["evictions"] = s.evictions;
+            entry["entries"]   = s.entries;
+            entry["time"]      = s.time;
+
+            result[s.function] = entry;
+        }
+
+        return result;
+    }
+
+    // converts a row-major matrix of doubles to a numpy array, copying the data in one go
+    object
+    to_ndarray(const std::vector<double> & data, const std::size_t & rows, const std::size_t & columns)
+    {
+        handle<> buffer(PyByteArray_FromStringAndSize(reinterpret_cast<const char *>(data.data()), data.size() * sizeof(double)));
+        object array = import("numpy").attr("frombuffer")(object(buffer), "float64");
+
+        if (0 == columns)
+            return array;
+
+        return array.attr("reshape")(make_tuple(rows, columns));
+    }
+
+    // releases the GIL for the lifetime of the object
+    struct ScopedGILRelease
+    {
+        PyThreadState * state;
+
+        ScopedGILRelease() :
+            state(PyEval_SaveThread())
+        {
+        }
+
+        ~ScopedGILRelease()
+        {
+            PyEval_RestoreThread(state);
+        }
+    };
+
+    // wrapper for ObservableCache::update_batch, accepting any two-dimensional array-like of parameter points
+    object
+    ObservableCache_update_batch(ObservableCache & cache, object parameters, object points)
+    {
+        std::vector<Parameter::Id> ids;
+        for (unsigned k = 0 ; k < len(parameters) ; ++k)
+        {
+            ids.push_back(extract<Parameter>(parameters[k])().id());
+        }
+
+        // access the points as a C-contiguous array of doubles
+        object array = import("numpy").attr("ascontiguousarray")(points, "float64");
+        Py_buffer view;
+        if (0 != PyObject_GetBuffer(array.ptr(), &view, PyBUF_C_CONTIGUOUS))
+            throw_error_already_set();
+
+        if ((2 != view.ndim) || (ids.size() != std::size_t(view.shape[1])))
+        {
+            PyBuffer_Release(&view);
+            PyErr_SetString(PyExc_ValueError, "points must be a two-dimensional array with one column per varied parameter");
+            throw_error_already_set();
+        }
+
+        const std::size_t n_points = view.shape[0];
+        const std::size_t n_predictions = cache.size();
+        std::vector<double> predictions(n_points * n_predictions);
+        try
+        {
+            ScopedGILRelease release;
+            cache.update_batch(ids, static_cast<const double *>(view.buf), n_points, ids.size(), predictions.data());
+        }
+        catch (...)
+        {
+            PyBuffer_Release(&view);
+            throw;
+        }
+        PyBuffer_Release(&view);
+
+        return to_ndarray(predictions, n_points, n_predictions);
+    }
+
+    // wrapper for LogPosterior::evaluate_batch, accepting any two-dimensional array-like of u-space points
+    object
+    LogPosterior_evaluate_batch(const LogPosterior & log_posterior, object u)
+    {
+        const std::size_t dim = log_posterior.varied_parameters().size();
+
+        // access the points as a C-contiguous array of doubles
+        object array = import("numpy").attr("ascontiguousarray")(u, "float64");
+        Py_buffer view;
+        if (0 != PyObject_GetBuffer(array.ptr(), &view, PyBUF_C_CONTIGUOUS))
+            throw_error_already_set();
+
+        if ((2 != view.ndim) || (dim != std::size_t(view.shape[1])))
+        {
+            PyBuffer_Release(&view);
+            PyErr_SetString(PyExc_ValueError, "u must be a two-dimensional array with one column per varied parameter");
+            throw_error_already_set();
+        }
+
+        const std::size_t n_points = view.shape[0];
+        std::vector<double> results(n_points);
+        try
+        {
+            ScopedGILRelease release;
+            log_posterior.evaluate_batch(static_cast<const double *>(view.buf), n_points, results.data());
+        }
+        catch (...)
+        {
+            PyBuffer_Release(&view);
+            throw;
+        }
+        PyBuffer_Release(&view);
+
+        return to_ndarray(results, 0, 0);
+    }
+
+    // applies one of the transformations between u space and parameter space to a one-dimensional array-like
+    object
+    LogPosterior_transform(LogPosterior & log_posterior, object x, void (LogPosterior::* transform)(const double *, double *))
+    {
+        const std::size_t dim = log_posterior.varied_parameters().size();
+
+        // access the point as a C-contiguous array of doubles
+        object array = import("numpy").attr("ascontiguousarray")(x, "float64");
+        Py_buffer view;
+        if (0 != PyObject_GetBuffer(array.ptr(), &view, PyBUF_C_CONTIGUOUS))
+            throw_error_already_set();
+
+        if ((1 != view.ndim) || (dim != std::size_t(view.shape[0])))
+        {
+            PyBuffer_Release(&view);
+            PyErr_SetString(PyExc_ValueError, "the point must be a one-dimensional array with one entry per varied parameter");
+            throw_error_already_set();
+        }
+
+        std::vector<double> result(dim);
+        try
+        {
+            (log_posterior.*transform)(static_cast<const double *>(view.buf), result.data());
+        }
+        catch (...)
+        {
+            PyBuffer_Release(&view);
+            throw;
+        }
+        PyBuffer_Release(&view);
+
+        return to_ndarray(result, 0, 0);
+    }
+
+    object
+    LogPosterior_set_from_u(LogPosterior & log_posterior, object u)
+    {
+        return LogPosterior_transform(log_posterior, u, &LogPosterior::set_from_u);
+    }
+
+    object
+    LogPosterior_set_from_par(LogPosterior & log_posterior, object par)
+    {
+        return LogPosterior_transform(log_posterior, par, &LogPosterior::set_from_par);
+    }
+
+    // exposes an array of doubles within a view of a Parameters object as a writable numpy array without copying;
+    // the numpy array keeps the view alive, which in turn keeps the array in place
+    object
+    Parameters_array(const std::shared_ptr<Parameters::View> & view, double * data)
+    {
+        dict interface;
+        interface["version"] = 3;
+        interface["shape"]   = make_tuple(view->size());
+        interface["typestr"] = import("numpy").attr("dtype")("float64").attr("str");
+        interface["data"]    = make_tuple(reinterpret_cast<std::uintptr_t>(data), false);
+
+        object owner = import("types").attr("SimpleNamespace")();
+        owner.attr("__array_interface__") = interface;
+        owner.attr("view") = object(view);
+
+        return import("numpy").attr("asarray")(owner);
+    }
+
+    object
+    Parameters_values(const Parameters & parameters)
+    {
+        auto view = parameters.view();
+
+        return Parameters_array(view, view->values());
+    }
+
+    object
+    Parameters_generator_values(const Parameters & parameters)
+    {
+        auto view = parameters.view();
+
+        return Parameters_array(view, view->generator_values());
+    }
+
+    // factory for MarkovChainSampler, converting the starting point from a Python sequence
+    std::shared_ptr<MarkovChainSampler>
+    make_markov_chain_sampler(const LogPosterior & log_posterior, unsigned chains, unsigned long seed, unsigned preruns,
+            unsigned pre_N, unsigned N, unsigned stride, double cov_scale, object start_point)
+    {
+        auto config = MarkovChainSampler::Config::Default();
+        config.number_of_chains = chains;
+        config.seed             = seed;
+        config.preruns          = preruns;
+        config.prerun_samples   = pre_N;
+        config.samples          = N;
+        config.stride           = stride;
+        config.cov_scale        = cov_scale;
+
+        if (! start_point.is_none())
+        {
+            for (unsigned i = 0 ; i < len(start_point) ; ++i)
+            {
+                config.start_point.push_back(extract<double>(start_point[i]));
+            }
+        }
+
+        return std::make_shared<MarkovChainSampler>(log_posterior, config);
+    }
+
+    object
+    LogPosterior_hessian(const LogPosterior & log_posterior, double relative_step)
+    {
+        const unsigned dim = log_posterior.varied_parameters().size();
+
+        return to_ndarray(log_posterior.hessian(relative_step), dim, dim);
+    }
+
+    object
+    LaplaceApproximation_mode(const LaplaceApproximation & laplace)
+    {
+        return to_ndarray(laplace.mode(), 0, 0);
+    }
+
+    object
+    LaplaceApproximation_hessian(const LaplaceApproximation & laplace)
+    {
+        return to_ndarray(laplace.hessian(), laplace.dimension(), laplace.dimension());
+    }
+
+    object
+    LaplaceApproximation_covariance(const LaplaceApproximation & laplace)
+    {
+        return to_ndarray(laplace.covariance(), laplace.dimension(), laplace.dimension());
+    }
+
+    std::shared_ptr<ProfileLikelihoodScan>
+    make_profile_likelihood_scan(const LogPosterior & log_posterior, object axes, unsigned max_iterations, double tolerance, double initial_step)
+    {
+        std::vector<ProfileLikelihoodScan::Axis> _axes;
+        for (unsigned i = 0 ; i < len(axes) ; ++i)
+        {
+            object axis = axes[i];
+            _axes.push_back(ProfileLikelihoodScan::Axis{ extract<std::string>(axis[0]), extract<double>(axis[1]), extract<double>(axis[2]), extract<unsigned>(axis[3]) });
+        }
+
+        auto config = ProfileLikelihoodScan::Config::Default();
+        config.max_iterations = max_iterations;
+        config.tolerance      = tolerance;
+        config.initial_step   = initial_step;
+
+        return std::make_shared<ProfileLikelihoodScan>(log_posterior, _axes, config);
+    }
+
+    object
+    ProfileLikelihoodScan_points(const ProfileLikelihoodScan & scan)
+    {
+        const auto & points = scan.points();
+        return to_ndarray(points, scan.number_of_points(), points.size() / scan.number_of_points());
+    }
+
+    object
+    ProfileLikelihoodScan_profiled_values(const ProfileLikelihoodScan & scan)
+    {
+        const auto & values = scan.profiled_values();
+        return to_ndarray(values, scan.number_of_points(), values.size() / scan.number_of_points());
+    }
+
+    object
+    ProfileLikelihoodScan_log_posterior_values(const ProfileLikelihoodScan & scan)
+    {
+        return to_ndarray(scan.log_posterior_values(), 0, 0);
+    }
+
+    object
+    ProfileLikelihoodScan_log_likelihood_values(const ProfileLikelihoodScan & scan)
+    {
+        return to_ndarray(scan.log_likelihood_values(), 0, 0);
+    }
+
+    unsigned
+    LogLikelihood_enable_polynomial_surrogates(LogLikelihood & log_likelihood, object coefficients)
+    {
+        std::list<std::string> names;
+        for (unsigned i = 0 ; i < len(coefficients) ; ++i)
+        {
+            names.push_back(extract<std::string>(coefficients[i]));
+        }
+
+        return log_likelihood.enable_polynomial_surrogates(names);
+    }
+
+    object
+    MarkovChainSampler_samples(const MarkovChainSampler & sampler, unsigned chain)
+    {
+        const auto & samples = sampler.samples(chain);
+        return to_ndarray(samples, samples.size() / sampler.dimension(), sampler.dimension());
+    }
+
+    object
+    MarkovChainSampler_usamples(const MarkovChainSampler & sampler, unsigned chain)
+    {
+        const auto & usamples = sampler.usamples(chain);
+        return to_ndarray(usamples, usamples.size() / sampler.dimension(), sampler.dimension());
+    }
+
+    object
+    MarkovChainSampler_weights(const MarkovChainSampler & sampler, unsigned chain)
+    {
+        return to_ndarray(sampler.log_posterior_values(chain), 0, 0);
+    }
+
+    object
+    MarkovChainSampler_r_values(const MarkovChainSampler & sampler)
+    {
+        return to_ndarray(sampler.r_values(), 0, 0);
+    }
 }
 
 BOOST_PYTHON_MODULE(_eos)
@@ -332,6 +675,24 @@ BOOST_PYTHON_MODULE(_eos)
             )")
         .def("has", &Parameters::has)
         .def("override_from_file", &Parameters::override_from_file)
+        .def("values", &::impl::Parameters_values,
+            R"(
+            Returns the numeric values of all parameters as a writable numpy array, indexed by the parameters' ids.
+
+            The array shares its memory with the parameters. As long as the array or any array derived from it exists,
+            declaring a new parameter raises an error, and all parameters are considered changed whenever observables
+            are updated.
+            )")
+        .def("generator_values", &::impl::Parameters_generator_values,
+            R"(
+            Returns the generator values of all parameters as a writable numpy array, indexed by the parameters' ids.
+
+            The array shares its memory with the parameters. As long as the array or any array derived from it exists,
+            declaring a new parameter raises an error.
+            )")
+        ;
+
+    class_<Parameters::View, std::shared_ptr<Parameters::View>, boost::noncopyable>("_ParametersView", no_init)
         ;
 
     // Mutable
@@ -348,18 +709,22 @@ BOOST_PYTHON_MODULE(_eos)
             via the :class:`eos.Parameters <eos.Parameters>` class, from which the parameter of interest can be extracted, inspected, and altered.
         )", no_init)
         .def(float_(self))
-        .def("central", &Parameter::central, return_value_policy<copy_const_reference>())
-        .def("max", &Parameter::max, return_value_policy<copy_const_reference>())
-        .def("min", &Parameter::min, return_value_policy<copy_const_reference>())
+        .def("central", &Parameter::central)
+        .def("max", &Parameter::max)
+        .def("min", &Parameter::min)
         .def("name", &Parameter::name, return_value_policy<copy_const_reference>(),
             R"(
             Returns the name of the parameter.
             )")
-        .def("latex", &Parameter::latex, return_value_policy<copy_const_reference>(),
+        .def("latex", &Parameter::latex,
             R"(
             Returns the LaTeX representation of the parameter.
             )")
         .def("unit", &Parameter::unit)
+        .def("id", &Parameter::id,
+            R"(
+            Returns the unique id of the parameter within its set of parameters.
+            )")
         .def("set", &Parameter::set,
             R"(
             Set the value of a parameter.
@@ -532,6 +897,17 @@ BOOST_PYTHON_MODULE(_eos)
         .def("alpha_s", &Model::alpha_s)
         ;
 
+    // EvaluationProfile
+    class_<EvaluationProfile>("EvaluationProfile", R"(
+        Profiling information for the evaluation of one observable or one likelihood block.
+    )", no_init)
+        .def_readonly("name", &EvaluationProfile::name)
+        .def_readonly("calls", &EvaluationProfile::calls)
+        .def_readonly("exceptions", &EvaluationProfile::exceptions)
+        .def_readonly("time", &EvaluationProfile::time)
+        ;
+    ::impl::std_vector_to_python_converter<EvaluationProfile> converter_evaluation_profiles;
+
     // ObservableCache
     class_<ObservableCache>("ObservableCache", R"(
         Provides a cache for the efficient evaluation of observables.
@@ -555,8 +931,50 @@ BOOST_PYTHON_MODULE(_eos)
         .def("update", &ObservableCache::update, R"(
             Update the cache for the current parameter point.
         )")
+        .def("update_batch", &::impl::ObservableCache_update_batch, R"(
+            Compute the predictions of all cached observables for a batch of parameter points.
+
+            The points are distributed across all available threads. The values stored in the
+            cache and the values of its parameters remain unchanged.
+
+            :param parameters: The varied parameters, corresponding to the columns of the points.
+            :type parameters: list of eos.Parameter
+            :param points: The values of the varied parameters, with one row per point.
+            :type points: 2D array-like of float
+
+            :returns: The predictions, with one row per point and one column per handle.
+            :rtype: numpy.ndarray
+        )", args("parameters", "points"))
+        .def("enable_profiling", &ObservableCache::enable_profiling, R"(
+            Enable or disable the profiling of the observables' evaluations.
+
+            While enabled, each update records the number of evaluations, the number of evaluations
+            that raised an exception, and the wall time spent for every observable.
+
+            :param enable: Whether the evaluations shall be profiled.
+            :type enable: bool
+        )", args("enable"))
+        .def("profile", &ObservableCache::profile, R"(
+            Retrieve the profiling information.
+
+            :returns: One entry per observable, in the order of their handles.
+            :rtype: list of eos.EvaluationProfile
+        )")
+        .def("reset_profile", &ObservableCache::reset_profile, R"(
+            Discard all profiling information recorded so far.
+        )")
         ;
 
+    // Memoisation
+    def("memoisation_statistics", &::impl::memoisation_statistics, R"(
+        Retrieve the counters of all memoised functions.
+
+        :returns: A dictionary keyed by the names of the memoised functions. Each value is a dictionary
+                  with the number of ``hits``, ``misses``, ``evictions``, and currently held ``entries``,
+                  as well as the total ``time`` in seconds spent evaluating the function.
+        :rtype: dict
+    )");
+
     // ReferenceName
     class_<ReferenceName>("ReferenceName", init<std::string>())
         .def("__str__", &ReferenceName::str, return_value_policy<copy_const_reference>())
@@ -583,6 +1001,33 @@ BOOST_PYTHON_MODULE(_eos)
         .def("__iter__", range(&LogLikelihood::begin, &LogLikelihood::end))
         .def("observable_cache", &LogLikelihood::observable_cache)
         .def("evaluate", &LogLikelihood::operator())
+        .def("enable_profiling", &LogLikelihood::enable_profiling, R"(
+            Enable or disable the profiling of the likelihood's evaluations, including those of its observables.
+
+            :param enable: Whether the evaluations shall be profiled.
+            :type enable: bool
+        )", args("enable"))
+        .def("profile", &LogLikelihood::profile, R"(
+            Retrieve the profiling information of the likelihood blocks.
+
+            The profiling information of the observables is available from ``observable_cache().profile()``.
+
+            :returns: One entry per likelihood block, in the order of the constraints.
+            :rtype: list of eos.EvaluationProfile
+        )")
+        .def("reset_profile", &LogLikelihood::reset_profile, R"(
+            Discard all profiling information recorded so far, including that of the observables.
+        )")
+        .def("enable_polynomial_surrogates", &::impl::LogLikelihood_enable_polynomial_surrogates, R"(
+            Replace the predictions by polynomials in the given coefficients, wherever their dependence on the coefficients is at most quadratic.
+
+            The polynomials are only reconstructed when any other parameter changes.
+
+            :param coefficients: The names of the coefficients, e.g. the varied Wilson coefficients.
+            :type coefficients: list of str
+            :returns: The number of predictions that have been replaced.
+            :rtype: int
+        )", args("coefficients"))
         ;
 
     // Constraint
@@ -700,11 +1145,180 @@ BOOST_PYTHON_MODULE(_eos)
         ;
 
     // LogPosterior
+    ::impl::std_vector_to_python_converter<double> converter_doubles;
     class_<LogPosterior>("LogPosterior", init<LogLikelihood>())
         .def("add", &LogPosterior::add)
         .def("log_likelihood", &LogPosterior::log_likelihood)
         .def("log_priors", range(&LogPosterior::begin_priors, &LogPosterior::end_priors))
         .def("evaluate", &LogPosterior::evaluate)
+        .def("gradient", &LogPosterior::gradient, (arg("relative_step") = 1.0e-4), R"(
+            Returns the gradient of the log(posterior) with respect to the varied parameters at the current parameter point.
+
+            The derivatives are estimated with a central-difference stencil that is evaluated in parallel.
+            The step sizes are a fraction of the ranges of the parameters' priors.
+
+            :param relative_step: The step size relative to the range of each parameter's prior.
+            :type relative_step: float, optional
+        )")
+        .def("hessian", &::impl::LogPosterior_hessian, (arg("relative_step") = 1.0e-3), R"(
+            Returns the Hessian matrix of the log(posterior) with respect to the varied parameters at the current parameter point.
+
+            The second derivatives are estimated with central-difference stencils that are evaluated in parallel.
+            Only entries whose parameters share a constraint or a prior are evaluated; all other entries vanish.
+
+            :param relative_step: The step size relative to the range of each parameter's prior.
+            :type relative_step: float, optional
+            :return: The Hessian matrix as numpy array of shape (D, D).
+        )")
+        .def("evaluate_batch", &::impl::LogPosterior_evaluate_batch, R"(
+            Returns the log(posterior) for a batch of points in u space as a numpy array.
+
+            The points are transformed to parameter space through the priors' inverse CDFs and evaluated
+            in parallel, without holding the global interpreter lock. Points outside the unit hypercube
+            and points for which the evaluation fails yield -inf.
+
+            :param u: The points in u space, with one row per point and one column per varied parameter.
+            :type u: numpy.ndarray of shape (N, D)
+        )", args("u"))
+        .def("set_from_u", &::impl::LogPosterior_set_from_u, R"(
+            Sets the varied parameters to a point in u space and returns the parameter values as a numpy array.
+
+            All priors transform the point through their inverse CDFs in a single call.
+
+            :param u: The point in u space, with one entry per varied parameter.
+            :type u: numpy.ndarray of shape (D,)
+        )", args("u"))
+        .def("set_from_par", &::impl::LogPosterior_set_from_par, R"(
+            Sets the varied parameters to a point in parameter space and returns the point in u space as a numpy array.
+
+            All priors transform the point through their CDFs in a single call.
+
+            :param par: The point in parameter space, with one entry per varied parameter.
+            :type par: numpy.ndarray of shape (D,)
+        )", args("par"))
+        ;
+
+    // LaplaceApproximation
+    class_<LaplaceApproximation, boost::noncopyable>("LaplaceApproximation", R"(
+            Approximates a log(posterior) by a multivariate Gaussian density around its mode.
+
+            The current parameter point of the log(posterior) is taken as the mode, e.g., the best-fit point
+            obtained from :meth:`eos.Analysis.optimize`. The covariance is the inverse of the negative Hessian matrix.
+
+            :param log_posterior: The log(posterior) that shall be approximated.
+            :type log_posterior: eos.LogPosterior
+            :param relative_step: The step size of the finite differences, relative to the range of each parameter's prior.
+            :type relative_step: float, optional
+        )", init<const LogPosterior &, double>((arg("log_posterior"), arg("relative_step") = 1.0e-3)))
+        .def("dimension", &LaplaceApproximation::dimension)
+        .def("mode", &::impl::LaplaceApproximation_mode, R"(
+            Returns the values of the varied parameters at the mode as a numpy array of shape (D,).
+        )")
+        .def("hessian", &::impl::LaplaceApproximation_hessian, R"(
+            Returns the Hessian matrix of the log(posterior) at the mode as a numpy array of shape (D, D).
+        )")
+        .def("covariance", &::impl::LaplaceApproximation_covariance, R"(
+            Returns the covariance matrix of the Gaussian approximation as a numpy array of shape (D, D).
+        )")
+        .def("log_posterior", &LaplaceApproximation::log_posterior, R"(
+            Returns the value of the log(posterior) at the mode.
+        )")
+        .def("log_evidence", &LaplaceApproximation::log_evidence, R"(
+            Returns the logarithm of the evidence in the Laplace approximation.
+        )")
+        ;
+
+    // MarkovChainSampler
+    class_<MarkovChainSampler, std::shared_ptr<MarkovChainSampler>, boost::noncopyable>("MarkovChainSampler", R"(
+            Samples from a log(posterior) with several independent, adaptive Metropolis chains.
+
+            The chains operate in the u space of the priors, and each chain runs on a separate thread
+            with its own random number stream. The Gelman-Rubin R value is computed after each prerun
+            and after the main run.
+
+            :param log_posterior: The log(posterior) from which samples shall be drawn.
+            :type log_posterior: eos.LogPosterior
+            :param chains: The number of independent chains.
+            :type chains: int, optional
+            :param seed: The seed of the first chain's random number stream. Chain i uses seed + i.
+            :type seed: int, optional
+            :param preruns: The number of preruns, after each of which the proposals are adapted.
+            :type preruns: int, optional
+            :param pre_N: The number of samples in each prerun.
+            :type pre_N: int, optional
+            :param N: The number of samples to be stored per chain.
+            :type N: int, optional
+            :param stride: The ratio of samples drawn over samples stored.
+            :type stride: int, optional
+            :param cov_scale: Scale factor for the initial guess of the proposal covariance matrix.
+            :type cov_scale: float, optional
+            :param start_point: Optional u-space starting point for all chains.
+            :type start_point: list-like, optional
+        )", no_init)
+        .def("__init__", make_constructor(&::impl::make_markov_chain_sampler, default_call_policies(),
+            (arg("log_posterior"), arg("chains") = 4, arg("seed") = 1701, arg("preruns") = 3, arg("pre_N") = 150,
+             arg("N") = 1000, arg("stride") = 5, arg("cov_scale") = 0.1, arg("start_point") = object())))
+        .def("run", &MarkovChainSampler::run, R"(
+            Runs all preruns, adapting the proposals, followed by the main run.
+        )")
+        .def("number_of_chains", &MarkovChainSampler::number_of_chains)
+        .def("samples", &::impl::MarkovChainSampler_samples, R"(
+            Returns the parameter samples of one chain as a numpy array of shape (N, D).
+        )", args("chain"))
+        .def("usamples", &::impl::MarkovChainSampler_usamples, R"(
+            Returns the u-space samples of one chain as a numpy array of shape (N, D).
+        )", args("chain"))
+        .def("weights", &::impl::MarkovChainSampler_weights, R"(
+            Returns the values of the log(posterior) for the samples of one chain as a numpy array of shape (N,).
+        )", args("chain"))
+        .def("acceptance_rates", &MarkovChainSampler::acceptance_rates, R"(
+            Returns the acceptance rate of each chain in the main run.
+        )")
+        .def("r_values", &::impl::MarkovChainSampler_r_values, R"(
+            Returns the Gelman-Rubin R value of each varied parameter as a numpy array, as obtained from the u-space samples of the main run.
+        )")
+        ;
+
+    // ProfileLikelihoodScan
+    class_<ProfileLikelihoodScan, std::shared_ptr<ProfileLikelihoodScan>, boost::noncopyable>("ProfileLikelihoodScan", R"(
+            Scans the profile of a log(posterior) on a grid in one or two parameters of interest.
+
+            At each grid point, the parameters of interest are fixed and the log(posterior) is maximised
+            with respect to all other varied parameters. The grid points are distributed across the thread pool,
+            and each point is started from the optima of its neighbours.
+
+            :param log_posterior: The log(posterior) whose profile shall be scanned.
+            :type log_posterior: eos.LogPosterior
+            :param axes: One or two axes of the grid, each given as a tuple (name, min, max, points).
+            :type axes: list of tuple
+            :param max_iterations: The maximal number of simplex iterations per minimisation.
+            :type max_iterations: int, optional
+            :param tolerance: The size of the simplex at convergence, relative to the ranges of the priors.
+            :type tolerance: float, optional
+            :param initial_step: The size of the initial simplex, relative to the ranges of the priors.
+            :type initial_step: float, optional
+        )", no_init)
+        .def("__init__", make_constructor(&::impl::make_profile_likelihood_scan, default_call_policies(),
+            (arg("log_posterior"), arg("axes"), arg("max_iterations") = 2000, arg("tolerance") = 1.0e-6, arg("initial_step") = 0.05)))
+        .def("run", &ProfileLikelihoodScan::run, R"(
+            Profiles the log(posterior) at all grid points.
+        )")
+        .def("number_of_points", &ProfileLikelihoodScan::number_of_points)
+        .def("profiled_parameter_names", &ProfileLikelihoodScan::profiled_parameter_names, R"(
+            Returns the names of the profiled parameters.
+        )")
+        .def("points", &::impl::ProfileLikelihoodScan_points, R"(
+            Returns the values of the parameters of interest as a numpy array of shape (N, number of axes). The last axis varies fastest.
+        )")
+        .def("profiled_values", &::impl::ProfileLikelihoodScan_profiled_values, R"(
+            Returns the optimal values of the profiled parameters as a numpy array of shape (N, number of profiled parameters).
+        )")
+        .def("log_posterior_values", &::impl::ProfileLikelihoodScan_log_posterior_values, R"(
+            Returns the maximal values of the log(posterior) as a numpy array of shape (N,).
+        )")
+        .def("log_likelihood_values", &::impl::ProfileLikelihoodScan_log_likelihood_values, R"(
+            Returns the values of the log(likelihood) at the optima as a numpy array of shape (N,).
+        )")
         ;
 
     // test_statistics::ChiSquare
@@ -63,11 +63,15 @@ class Analysis:
     :type fixed_parameters: dict, optional
     :param parameters: The optional set of parameters that shall be used for this analysis. Defaults to `None` which means that a new instance of :class:`eos.Parameters` is created.
     :type parameters: :class:`eos.Parameters` or None, optional
+    :param polynomial_surrogates: If true, each prediction whose dependence on the varied parameters is at most quadratic is replaced by a polynomial in these parameters.
+        This is intended for analyses that vary only Wilson coefficients of the WET, e.g. ``b->smumu::Re{c9}``, while all hadronic parameters remain fixed. Defaults to `False`.
+    :type polynomial_surrogates: bool, optional
     """
 
-    def __init__(self, priors, likelihood, global_options={}, manual_constraints={}, fixed_parameters={}, parameters=None):
+    def __init__(self, priors, likelihood, global_options={}, manual_constraints={}, fixed_parameters={}, parameters=None, polynomial_surrogates=False):
         """Constructor."""
-        self.init_args = { 'priors': priors, 'likelihood': likelihood, 'global_options': global_options, 'manual_constraints': manual_constraints, 'fixed_parameters':fixed_parameters }
+        self.init_args = { 'priors': priors, 'likelihood': likelihood, 'global_options': global_options, 'manual_constraints': manual_constraints, 'fixed_parameters':fixed_parameters,
+                           'polynomial_surrogates': polynomial_surrogates }
         self.parameters = parameters if parameters else eos.Parameters.Defaults()
         """The set of parameters used for this analysis."""
         self.global_options = eos.Options()
@@ -192,23 +196,20 @@ class Analysis:
         for n in varied_parameter_names - used_parameter_names:
             eos.warn('likelihood does not depend on parameter \'{}\'; remove from prior or check options!'.format(n))
 
+        # replace the eligible predictions by polynomials in the varied parameters
+        if polynomial_surrogates:
+            n_surrogates = self._log_likelihood.enable_polynomial_surrogates([p.name() for p in self.varied_parameters])
+            eos.info('replaced {} prediction(s) by polynomial surrogates'.format(n_surrogates))
+
 
     def _u_to_par(self, u):
         """Internal function that uses the inverse prior transform to translate from u ∈ [0, 1)^D to the parameter space"""
-        for p, uv in zip(self.varied_parameters, u):
-            p.set_generator(uv)
-        for prior in self._log_posterior.log_priors():
-            prior.sample()
-        return np.array([p.evaluate() for p in self.varied_parameters])
+        return self._log_posterior.set_from_u(u)
 
 
     def _par_to_u(self, par):
         """Internal function that used the CDF to translate from parameter space to u ∈ [0, 1)^D."""
-        for p, pv in zip(self.varied_parameters, par):
-            p.set(pv)
-        for prior in self._log_posterior.log_priors():
-            prior.compute_cdf()
-        return np.array([p.evaluate_generator() for p in self.varied_parameters])
+        return self._log_posterior.set_from_par(par)
 
 
     @staticmethod
@@ -276,14 +277,8 @@ class Analysis:
 
         """
         if str(start_point) == "random":
-            # generate random uniform probabilities and store them in the generator values
-            for param in self.varied_parameters:
-                param.set_generator(rng.uniform())
-            # sample the priors by using an inverse transform sampling based on the previously provided generator values
-            for prior in self._log_posterior.log_priors():
-                prior.sample()
-            # use the sampled parameter point
-            _start_point = [float(p) for p in self.varied_parameters]
+            # sample the priors by using an inverse transform sampling of random uniform probabilities
+            _start_point = list(self._u_to_par([rng.uniform() for _ in self.varied_parameters]))
         elif start_point is None:
             # use the current parameter point
             _start_point = [float(p) for p in self.varied_parameters]
@@ -291,6 +286,9 @@ class Analysis:
             _start_point = np.array(start_point)
 
         scipy_opt_kwargs = { 'method': 'SLSQP', 'options': { 'ftol': 1.0e-13 } }
+        # Use the native gradient if the prior transform factorizes into one-dimensional transforms
+        if all(len(list(prior.varied_parameters())) == 1 for prior in self._log_posterior.log_priors()):
+            scipy_opt_kwargs['jac'] = self.negative_log_pdf_gradient
         # Update default values. If no keyword arguments are passed, kwargs is an empty dict
         scipy_opt_kwargs.update(kwargs)
 
@@ -315,6 +313,34 @@ class Analysis:
         return eos.BestFitPoint(self, bfp)
 
 
+    def laplace(self, relative_step=1.0e-3):
+        """
+        Return the Laplace approximation of the posterior at the current parameter point.
+
+        Uses the native :class:`eos.LaplaceApproximation`, which evaluates the Hessian matrix of the log(posterior)
+        in parallel. The current parameter point should be the mode of the posterior, e.g., as obtained from :meth:`optimize`.
+        The covariance in u space follows from dx/du = 1 / prior(x), and is suitable as initial proposal covariance
+        for :meth:`sample`, or to construct the initial proposal for :meth:`sample_pmc`. It requires that
+        all priors are one-dimensional; otherwise, None is returned in its place.
+
+        :param relative_step: Step size of the finite differences relative to the range of each parameter's prior.
+
+        :return: A tuple of the covariance matrix in parameter space as array of size D x D, the covariance matrix in u space
+            as array of size D x D, and the logarithm of the evidence.
+        """
+        laplace = eos.LaplaceApproximation(self._log_posterior, relative_step=relative_step)
+        covariance = laplace.covariance()
+
+        u_covariance = None
+        if all(len(list(prior.varied_parameters())) == 1 for prior in self._log_posterior.log_priors()):
+            du_dx = np.array([np.exp(prior.evaluate()) for prior in self._log_posterior.log_priors()])
+            u_covariance = covariance * np.outer(du_dx, du_dx)
+
+        eos.info('Laplace approximation of the log(evidence): {:.3f}'.format(laplace.log_evidence()))
+
+        return (covariance, u_covariance, laplace.log_evidence())
+
+
     def log_pdf(self, u, *args):
         """
         Adapter for use with external optimization software (e.g. pypmc) to aid when optimizing the log(posterior).
@@ -347,8 +373,57 @@ class Analysis:
         return -self.log_pdf(u, *args)
 
 
+    def negative_log_pdf_gradient(self, u, *args):
+        """
+        Adapter for use with external optimization software (e.g. scipy.optimize.minimize) that returns the gradient of :meth:`negative_log_pdf`.
+
+        The gradient is evaluated in parameter space and transformed to u space. This requires that
+        all priors are one-dimensional. If the gradient cannot be evaluated, it is estimated from
+        finite differences of :meth:`negative_log_pdf` in u space instead.
+
+        :param u: Parameter point in u space, with the elements in the same order as in eos.Analysis.varied_parameters.
+        :type u: iterable
+        :param args: Dummy parameter (ignored)
+        :type args: optional
+        """
+        self._u_to_par(u)
+
+        # the inverse prior transform x(u) has the derivative dx/du = 1 / prior(x)
+        dx_du = []
+        for prior in self._log_posterior.log_priors():
+            if len(list(prior.varied_parameters())) != 1:
+                raise ValueError('negative_log_pdf_gradient requires one-dimensional priors')
+            dx_du.append(np.exp(-prior.evaluate()))
+
+        try:
+            gradient = np.array(self._log_posterior.gradient())
+        except RuntimeError as e:
+            eos.warn('encountered run time error ({e}) when evaluating the gradient of log(posterior); falling back to finite differences in u space'.format(e=e))
+            return self._negative_log_pdf_finite_difference_gradient(u)
+
+        return -gradient * np.array(dx_du)
+
+
+    def _negative_log_pdf_finite_difference_gradient(self, u):
+        # one-sided differences, stepping towards the interior of the unit hypercube
+        u = np.array(u, dtype=float)
+        h = np.sqrt(np.finfo(float).eps)
+        f0 = self.negative_log_pdf(u)
+        gradient = np.empty(len(u))
+        for i in range(len(u)):
+            step = h if u[i] + h <= 1.0 else -h
+            u_step = u.copy()
+            u_step[i] += step
+            gradient[i] = (self.negative_log_pdf(u_step) - f0) / step
+
+        # restore the parameter point
+        self._u_to_par(u)
+
+        return gradient
+
+
     def sample(self, N=1000, stride=5, pre_N=150, preruns=3, cov_scale=0.1, observables=None, start_point=None, rng=np.random.mtrand,
-               return_uspace=False):
+               return_uspace=False, initial_covariance=None):
         """
         Return samples of the parameters, log(weights), and optionally posterior-predictive samples for a sequence of observables.
 
@@ -365,6 +440,8 @@ class Analysis:
         :param start_point: Optional starting point for the chain
         :type start_point: list-like, optional
         :param rng: Optional random number generator (must be compatible with the requirements of pypmc.sampler.markov_chain.MarkovChain)
+        :param initial_covariance: Optional initial covariance matrix in u space, e.g., as obtained from :meth:`laplace`. If provided, cov_scale is ignored.
+        :type initial_covariance: array of size D x D, optional
 
         :return: A tuple of the parameters as array of size N, the logarithmic weights as array of size N, and optionally the posterior-predictive samples of the observables as array of size N x len(observables).
 
@@ -385,6 +462,8 @@ class Analysis:
 
         # create initial covariance, assuming that each parameter's u-space value is uniformly distributed on [0, 1)
         sigma = np.diag([1.0 / 12.0 * cov_scale for _ in self.varied_parameters])   # 1 / 12 is the vairance U(0, 1)
+        if initial_covariance is not None:
+            sigma = np.array(initial_covariance)
         log_proposal = pypmc.density.gauss.LocalGauss(sigma)
 
         # create start point, if not provided or transform a provided start point to u space
@@ -437,6 +516,69 @@ class Analysis:
             return(parameter_samples, weights, np.array(observable_samples))
 
 
+    def sample_chains(self, chains=4, N=1000, stride=5, pre_N=150, preruns=3, cov_scale=0.1, start_point=None, seed=1701):
+        """
+        Return samples of the parameters and log(weights) from several independent Markov chains.
+
+        Obtains random samples of the log(posterior) using the native adaptive Metropolis sampler :class:`eos.MarkovChainSampler`.
+        The chains run in parallel on separate threads, each with its own random number stream.
+        Preruns with adaptations are carried out first and their samples are discarded.
+
+        :param chains: Number of independent chains.
+        :param N: Number of samples that shall be returned per chain.
+        :param stride: Stride, i.e., the number by which the actual amount of samples shall be thinned to return N samples.
+        :param pre_N: Number of samples in each prerun.
+        :param preruns: Number of preruns.
+        :param cov_scale: Scale factor for the initial guess of the covariance matrix.
+        :param start_point: Optional starting point for all chains
+        :type start_point: list-like, optional
+        :param seed: Seed of the first chain's random number stream. Chain i uses seed + i.
+
+        :return: A tuple of a list of per-chain tuples (parameter samples as array of size N x D, u-space samples as array of size N x D, logarithmic weights as array of size N),
+            and the Gelman-Rubin R values for each parameter as array of size D.
+        """
+        if start_point is not None:
+            start_point = list(self._par_to_u(start_point))
+
+        sampler = eos.MarkovChainSampler(self._log_posterior, chains=chains, seed=seed, preruns=preruns, pre_N=pre_N,
+                                         N=N, stride=stride, cov_scale=cov_scale, start_point=start_point)
+        sampler.run()
+
+        for i, rate in enumerate(sampler.acceptance_rates()):
+            eos.info('Main run: acceptance rate of chain {} is {:3.0f}%'.format(i, rate * 100))
+        r_values = sampler.r_values()
+        if chains > 1:
+            eos.info('Main run: largest R value is {:.3f}'.format(np.max(r_values)))
+
+        results = [(sampler.samples(i), sampler.usamples(i), sampler.weights(i)) for i in range(chains)]
+
+        return (results, r_values)
+
+
+    def profile(self, axes, max_iterations=2000, tolerance=1.0e-6, initial_step=0.05):
+        """
+        Return the profile of the log(posterior) on a grid in one or two parameters of interest.
+
+        Uses the native :class:`eos.ProfileLikelihoodScan`. At each grid point, the parameters of interest
+        are fixed and the log(posterior) is maximised with respect to all other varied parameters.
+        The grid points are distributed across the thread pool.
+
+        :param axes: One or two axes of the grid, each given as a tuple (name, min, max, points).
+        :type axes: list of tuple
+        :param max_iterations: Maximal number of simplex iterations per grid point.
+        :param tolerance: Size of the simplex at convergence, relative to the ranges of the priors.
+        :param initial_step: Size of the initial simplex, relative to the ranges of the priors.
+
+        :return: A tuple of the values of the parameters of interest as array of size N x A, the optimal values of the profiled
+            parameters as array of size N x P, the profiled log(posterior) as array of size N, and the log(likelihood) at the optima as array of size N.
+        """
+        scan = eos.ProfileLikelihoodScan(self._log_posterior, list(axes), max_iterations=max_iterations,
+                                         tolerance=tolerance, initial_step=initial_step)
+        scan.run()
+
+        return (scan.points(), scan.profiled_values(), scan.log_posterior_values(), scan.log_likelihood_values())
+
+
     def sample_pmc(self, log_proposal, step_N=1000, steps=10, final_N=5000, rng=np.random.mtrand,
                     return_final_only=True, final_perplexity_threshold=1.0, weight_threshold=1e-10,
                     pmc_iterations=1, pmc_rel_tol=1e-10, pmc_abs_tol=1e-05, pmc_lookback=1):
@@ -513,7 +655,7 @@ class Analysis:
 
         # carry out adaptions
         for step in progressbar(range(steps), desc="Adaptions", leave=False):
-            origins = sampler.run(step_N, trace_sort=True)
+            origins = self._run_importance_sampler(sampler, step_N)
             generating_components.append(origins)
 
             # Compute the indicators for the current step
@@ -555,7 +697,7 @@ class Analysis:
                 break
 
         # draw final samples
-        origins = sampler.run(final_N, trace_sort=True)
+        origins = self._run_importance_sampler(sampler, final_N)
         generating_components.append(origins)
 
         # transform the samples back from u space to parameter space
@@ -576,6 +718,27 @@ class Analysis:
         return samples, weights, posterior_values, sampler.proposal
 
 
+    def _run_importance_sampler(self, sampler, N):
+        """
+        Internal function that draws N samples from the proposal of a pypmc.sampler.importance_sampling.ImportanceSampler and weights them.
+
+        This is equivalent to sampler.run(N, trace_sort=True), except that the log(posterior) is evaluated
+        for all samples in one call to :meth:`eos.LogPosterior.evaluate_batch`, i.e., in parallel and without
+        holding the global interpreter lock.
+        """
+        samples, origins = sampler.proposal.propose(N, sampler.rng, trace=True, shuffle=False)
+        target_values = self._log_posterior.evaluate_batch(samples)
+        failures = np.count_nonzero(np.isneginf(target_values))
+        if failures > 0:
+            eos.debug(f'{failures} out of {N} samples have a vanishing posterior density')
+
+        sampler.samples.append(N)[:] = samples
+        sampler.weights.append(N)[:, 0] = np.exp(target_values - sampler.proposal.multi_evaluate(samples))
+        sampler.target_values.append(N)[:, 0] = target_values
+
+        return origins
+
+
     def log_likelihood(self, p, *args):
         """
         Adapter for use with external sampling software (e.g. dynesty) to aid when sampling from the log(likelihood).
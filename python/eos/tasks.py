@@ -16,10 +16,13 @@
 # Place, Suite 330, Boston, MA  02111-1307  USA
 
 import eos
+import concurrent.futures
 import contextlib
+import fnmatch
 import functools
 import inspect
 import logging
+import multiprocessing
 import numpy as _np
 import os
 import pypmc
@@ -46,8 +49,22 @@ class LogfileHandler:
 
 
 _tasks = {}
+_task_paths = {}
 
-def task(name, output, mode=lambda **kwargs: 'w'):
+def task(name, output, mode=lambda **kwargs: 'w', inputs=None, outputs=lambda **kwargs: []):
+    """
+    Registers a function as a named task.
+
+    The paths that the task reads and writes, relative to the base directory, are used to infer
+    the dependencies between the steps of an analysis. They are provided as functions of the task's arguments.
+    The inputs may contain wildcards. Tasks without information on their inputs are never run concurrently with other tasks.
+
+    :param name: The name of the task.
+    :param output: The output path, as a format string of the task's arguments.
+    :param mode: The mode of the task's log file.
+    :param inputs: Function that returns the list of paths that the task reads.
+    :param outputs: Function that returns the list of paths that the task writes in addition to the output path.
+    """
     def _task(func):
         @functools.wraps(func)
         def task_wrapper(*args, **kwargs):
@@ -83,11 +100,14 @@ def task(name, output, mode=lambda **kwargs: 'w'):
                         iaccordion.selected_index = None
                     return result
         _tasks[name] = task_wrapper
+        _task_paths[name] = (output, inputs, outputs)
         return task_wrapper
     return _task
 
 
-@task('find-mode', '{posterior}/mode-{label}')
+@task('find-mode', '{posterior}/mode-{label}',
+      inputs=lambda posterior, chain, importance_samples, **kwargs:
+          ([f'{posterior}/mcmc-{chain:04}'] if chain is not None else []) + ([f'{posterior}/samples'] if importance_samples else []))
 def find_mode(analysis_file:str, posterior:str, base_directory:str='./', optimizations:int=3, start_point:list=None, chain:int=None,
               importance_samples:bool=None, seed:int=None, label:str='default'):
     '''
@@ -204,8 +224,10 @@ def find_mode(analysis_file:str, posterior:str, base_directory:str='./', optimiz
     return (bfp, gof)
 
 
-@task('sample-mcmc', '{posterior}/mcmc-{chain:04}')
-def sample_mcmc(analysis_file:str, posterior:str, chain:int, base_directory:str='./', pre_N:int=150, preruns:int=3, N:int=1000, stride:int=5, cov_scale:float=0.1, start_point:list=None):
+@task('sample-mcmc', '{posterior}/mcmc-{chain:04}', inputs=lambda **kwargs: [],
+      outputs=lambda posterior, chain, chains, **kwargs: [f'{posterior}/mcmc-{chain + i:04}' for i in range(chains or 0)])
+def sample_mcmc(analysis_file:str, posterior:str, chain:int, base_directory:str='./', pre_N:int=150, preruns:int=3, N:int=1000, stride:int=5, cov_scale:float=0.1, start_point:list=None,
+                chains:int=None):
     """
     Samples from a named posterior PDF using Markov Chain Monte Carlo (MCMC) methods.
 
@@ -231,9 +253,22 @@ def sample_mcmc(analysis_file:str, posterior:str, chain:int, base_directory:str=
     :type cov_scale: float, optional
     :param start_point: Optional starting point for the chain
     :type start_point: list-like, optional
+    :param chains: If provided, this number of chains is run in parallel with the native sampler. The chains are stored in EOS_BASE_DIRECTORY/POSTERIOR/mcmc-CHAIN, ..., mcmc-(CHAIN + CHAINS - 1).
+    :type chains: int, optional
     """
 
     analysis = analysis_file.analysis(posterior)
+
+    if chains is not None:
+        try:
+            results, r_values = analysis.sample_chains(chains=chains, N=N, stride=stride, pre_N=pre_N, preruns=preruns, cov_scale=cov_scale,
+                                                       start_point=start_point, seed=int(chain) + 1701)
+            for i, (samples, usamples, weights) in enumerate(results):
+                eos.data.MarkovChain.create(os.path.join(base_directory, posterior, f'mcmc-{chain + i:04}'), analysis.varied_parameters, samples, usamples, weights)
+        except RuntimeError as e:
+            eos.error('encountered run time error ({e}) when running the native sampler'.format(e=e))
+        return
+
     rng = _np.random.mtrand.RandomState(int(chain) + 1701)
     try:
         samples, usamples, weights = analysis.sample(N=N, stride=stride, pre_N=pre_N, preruns=preruns, rng=rng, cov_scale=cov_scale, start_point=start_point, return_uspace=True)
@@ -244,7 +279,7 @@ def sample_mcmc(analysis_file:str, posterior:str, chain:int, base_directory:str=
             eos.error(' - {n}: {v}'.format(n=p.name(), v=p.evaluate()))
 
 
-@task('find-clusters', '{posterior}/clusters')
+@task('find-clusters', '{posterior}/clusters', inputs=lambda posterior, **kwargs: [f'{posterior}/mcmc-*'])
 def find_clusters(posterior:str, base_directory:str='./', threshold:float=2.0, K_g:int=1, analysis_file:str=None):
     """
     Finds clusters among posterior MCMC samples, grouped by Gelman-Rubin R value, and creates a Gaussian mixture density.
@@ -279,7 +314,7 @@ def find_clusters(posterior:str, base_directory:str='./', threshold:float=2.0, K
     eos.data.MixtureDensity.create(os.path.join(base_directory, posterior, 'clusters'), density)
 
 
-@task('mixture-product', '{posterior}/product')
+@task('mixture-product', '{posterior}/product', inputs=lambda posteriors, **kwargs: [f'{p}/pmc' for p in posteriors])
 def mixture_product(posterior:str, posteriors:list, base_directory:str='./', analysis_file:str=None):
     """
     Compute the cartesian product of the densities listed in posteriors. Note that this product is not commutative.
@@ -301,7 +336,9 @@ def mixture_product(posterior:str, posteriors:list, base_directory:str='./', ana
 
 
 # Sample PMC
-@task('sample-pmc', '{posterior}/pmc', mode=lambda initial_proposal, **kwargs: 'a' if initial_proposal != 'clusters' else 'a')
+@task('sample-pmc', '{posterior}/pmc', mode=lambda initial_proposal, **kwargs: 'a' if initial_proposal != 'clusters' else 'a',
+      inputs=lambda posterior, initial_proposal, **kwargs: [f'{posterior}/{initial_proposal}'],
+      outputs=lambda posterior, **kwargs: [f'{posterior}/samples'])
 def sample_pmc(analysis_file:str, posterior:str, base_directory:str='./', step_N:int=500, steps:int=10, final_N:int=5000,
                perplexity_threshold:float=1.0, weight_threshold:float=1e-10, sigma_test_stat:list=None, initial_proposal:str='clusters',
                pmc_iterations:int=1, pmc_rel_tol:float=1e-10, pmc_abs_tol:float=1e-05, pmc_lookback:int=1):
@@ -376,7 +413,7 @@ def sample_pmc(analysis_file:str, posterior:str, base_directory:str='./', step_N
 
 
 # Predict observables
-@task('predict-observables', '{posterior}/pred-{prediction}')
+@task('predict-observables', '{posterior}/pred-{prediction}', inputs=lambda posterior, **kwargs: [f'{posterior}/samples'])
 def predict_observables(analysis_file:str, posterior:str, prediction:str, base_directory:str='./', begin:int=0, end:int=None):
     '''
     Predicts a set of observables based on previously obtained importance samples.
@@ -404,32 +441,80 @@ def predict_observables(analysis_file:str, posterior:str, prediction:str, base_d
 
     data = eos.data.ImportanceSamples(os.path.join(base_directory, posterior, 'samples'))
 
-    try:
-        from tqdm.auto import tqdm
-        progressbar = tqdm
-    except ImportError:
-        progressbar = lambda x: x
-
     parameters = [_parameters[p['name']] for p in data.varied_parameters]
-    observable_samples = []
-    for i, sample in enumerate(progressbar(data.samples[begin:end])):
-        for p, v in zip(parameters, sample):
-            p.set(v)
-        try:
-            cache.update()
-            observable_samples.append([cache[id] for id in observable_ids])
-        except RuntimeError as e:
-            eos.error('skipping prediction for sample {i} due to runtime error ({e}): {s}'.format(i=i, e=e, s=sample))
-            observable_samples.append([_np.nan for _ in observable_ids])
-    observable_samples = _np.array(observable_samples)
+    # evaluate all samples in parallel; failed predictions are reported as NaN
+    observable_samples = cache.update_batch(parameters, data.samples[begin:end])[:, observable_ids]
 
     output_path = os.path.join(base_directory, posterior, 'pred-{}'.format(prediction))
     eos.data.Prediction.create(output_path, observables, observable_samples, data.weights[begin:end])
 
 
+# Profile the evaluation of a posterior
+@task('profile-runtime', '{posterior}/runtime', inputs=lambda **kwargs: [])
+def profile_runtime(analysis_file:str, posterior:str, base_directory:str='./', N:int=100, seed:int=None):
+    '''
+    Profiles the evaluation of the named posterior.
+
+    The log(posterior) is evaluated in N random points drawn from the priors. For each observable and each
+    likelihood block, the number of evaluations, the number of evaluations that raised an exception,
+    and the accumulated wall time are recorded. The report will be stored in EOS_BASE_DIRECTORY/POSTERIOR/runtime.
+
+    :param analysis_file: The name of the analysis file that describes the named posterior, or an object of class `eos.AnalysisFile`.
+    :type analysis_file: str or `eos.AnalysisFile`
+    :param posterior: The name of the posterior PDF that will be profiled.
+    :type posterior: str
+    :param base_directory: The base directory for the storage of data files. Can also be set via the EOS_BASE_DIRECTORY environment variable.
+    :type base_directory: str, optional
+    :param N: The number of random points in which the posterior is evaluated. Defaults to 100.
+    :type N: int, optional
+    :param seed: The seed used to generate the random points. Defaults to 17.
+    :type seed: int, optional
+    '''
+    import yaml
+
+    if N < 1:
+        raise ValueError('The number of evaluations should be larger than zero.')
+
+    if seed is None:
+        seed = 17
+
+    analysis = analysis_file.analysis(posterior)
+    log_likelihood = analysis._log_likelihood
+    log_likelihood.enable_profiling(True)
+
+    rng = _np.random.mtrand.RandomState(seed)
+    eos.info(f'Profiling {N} evaluations of the posterior')
+    for u in rng.uniform(0.0, 1.0, size=(N, len(analysis.varied_parameters))):
+        analysis.log_pdf(u)
+
+    log_likelihood.enable_profiling(False)
+
+    def _entries(profile):
+        return sorted([
+            { 'name': p.name, 'calls': int(p.calls), 'exceptions': int(p.exceptions), 'time': float(p.time) }
+            for p in profile
+        ], key=lambda e: e['time'], reverse=True)
+
+    report = {
+        'evaluations': N,
+        'observables': _entries(log_likelihood.observable_cache().profile()),
+        'likelihood-blocks': _entries(log_likelihood.profile()),
+    }
+
+    for key in ['observables', 'likelihood-blocks']:
+        eos.info(f'{key}, by accumulated wall time:')
+        for e in report[key]:
+            eos.info(f'  - {e["name"]}: {e["time"]:.6f} s in {e["calls"]} calls, {e["exceptions"]} exceptions')
+
+    with open(os.path.join(base_directory, posterior, 'runtime', 'profile.yaml'), 'w') as f:
+        yaml.dump(report, f, sort_keys=False)
+
+    return report
+
+
 # Run analysis steps
 @task('run', '')
-def run(analysis_file:str, base_directory:str='./', dry_run:bool=False, executor:str='serial'):
+def run(analysis_file:str, base_directory:str='./', dry_run:bool=False, executor:str='serial', jobs:int=None):
     """
     Runs a list of predefined steps recorded in the analysis file.
 
@@ -445,11 +530,16 @@ def run(analysis_file:str, base_directory:str='./', dry_run:bool=False, executor
     :type base_directory: str, optional
     :param dry_run: The flag that disables execution and insteads prints the full information on the tasks that would be run to standard output. Defaults to `False`.
     :type dry_run: bool, optional
-    :param executor: The flag that governs the execution type for the tasks. Currently only supports `serial` execution. Defaults to `serial`.
+    :param executor: The flag that governs the execution type for the tasks. Supports `serial` and `parallel` execution. Defaults to `serial`.
     :type executor: str, optional
+    :param jobs: The maximal number of tasks that are run concurrently by the `parallel` executor. Defaults to the number of available processors.
+    :type jobs: int, optional
     """
     try:
-        exec = Executor.make(executor, steps=analysis_file.steps(base_directory), dry_run=dry_run)
+        kwargs = { 'steps': analysis_file.steps(base_directory), 'dry_run': dry_run }
+        if jobs is not None:
+            kwargs.update({ 'jobs': jobs })
+        exec = Executor.make(executor, **kwargs)
         exec.run()
         exec.join()
     except Exception as e:
@@ -457,7 +547,8 @@ def run(analysis_file:str, base_directory:str='./', dry_run:bool=False, executor
 
 
 # Nested sampling
-@task('sample-nested', '{posterior}/nested')
+@task('sample-nested', '{posterior}/nested', inputs=lambda **kwargs: [],
+      outputs=lambda posterior, **kwargs: [f'{posterior}/dynesty_results', f'{posterior}/samples'])
 def sample_nested(analysis_file:str, posterior:str, base_directory:str='./', bound:str='multi', nlive:int=250, dlogz:float=1.0, maxiter:int=None, seed:int=10):
     """
     Samples from a likelihood associated with a named posterior using dynamic nested sampling.
@@ -493,7 +584,8 @@ def sample_nested(analysis_file:str, posterior:str, base_directory:str='./', bou
 
 
 # Corner plot
-@task('corner-plot', '{posterior}/plots')
+@task('corner-plot', '{posterior}/plots',
+      inputs=lambda posterior, distribution, **kwargs: [f'{posterior}/samples' if distribution == 'posterior' else f'{posterior}/pred-{distribution}'])
 def corner_plot(analysis_file:str, posterior:str, base_directory:str='./', format:str='pdf', distribution:str='posterior'):
     """
     Generates a corner plot of the 1-D and 2-D marginalized posteriors.
@@ -615,3 +707,143 @@ class SerialExecutor(Executor):
                 _tasks[task](**arguments)
 
 Executor.register('serial', SerialExecutor)
+
+
+def _step_paths(task, arguments):
+    """Internal function that returns the paths that a step reads and writes, or None if they are unknown."""
+    output, inputs, outputs = _task_paths[task]
+    if inputs is None:
+        return None
+
+    _args = {
+        k: v.default
+        for k, v in inspect.signature(_tasks[task]).parameters.items()
+        if v.default is not inspect.Parameter.empty
+    }
+    _args.update(arguments)
+
+    reads  = [os.path.normpath(p) for p in inputs(**_args)]
+    writes = [os.path.normpath(p) for p in [output.format(**_args)] + outputs(**_args)]
+
+    return (reads, writes)
+
+
+def _paths_overlap(lhs, rhs):
+    """Internal function that determines if any two paths or wildcard patterns of two lists match each other."""
+    return any(fnmatch.fnmatchcase(l, r) or fnmatch.fnmatchcase(r, l) for l in lhs for r in rhs)
+
+
+def _initialize_worker(threads, level):
+    """Internal function that prepares a worker process of the ParallelExecutor."""
+    if 'EOS_MAX_THREADS' not in os.environ:
+        os.environ['EOS_MAX_THREADS'] = str(threads)
+    eos.logger.setLevel(level)
+
+
+def _run_step(task, arguments):
+    """Internal function that runs a single step within a worker process of the ParallelExecutor."""
+    _tasks[task](**arguments)
+
+
+class ParallelExecutor(Executor):
+    """
+    Runs the steps of an analysis concurrently in separate processes.
+
+    The dependencies between the steps are inferred from the paths that their tasks read and write.
+    A step depends on an earlier step if it reads from or writes to any of the earlier step's outputs,
+    or if it writes to any of the earlier step's inputs. All other steps, e.g., independent Markov chains or
+    the steps of independent posteriors, are run concurrently. Each worker process limits the number
+    of its threads, such that the workers share the available processors.
+
+    :param steps: The steps of the analysis, as returned by `eos.AnalysisFile.steps`.
+    :param dry_run: Prints the steps and their dependencies instead of running them.
+    :param jobs: The maximal number of concurrent worker processes. Defaults to the number of available processors.
+    """
+    def __init__(self, steps, dry_run=False, jobs=None):
+        Executor.__init__(self, steps, dry_run)
+        self._jobs = jobs if jobs is not None else os.cpu_count()
+        if self._jobs < 1:
+            raise ValueError(f'Task "run" requires a positive number of jobs, got {self._jobs}')
+
+        self._dependencies = self._infer_dependencies()
+        self._pool = None
+        self._running = {}
+        self._remaining = set(range(len(self._steps)))
+        self._finished = set()
+        self._exception = None
+
+    def _infer_dependencies(self):
+        paths = [_step_paths(task, arguments) for _, _, task, arguments in self._steps]
+        dependencies = []
+        for i, lhs in enumerate(paths):
+            deps = set()
+            for j, rhs in enumerate(paths[:i]):
+                if lhs is None or rhs is None:
+                    deps.add(j)
+                elif _paths_overlap(lhs[0], rhs[1]) or _paths_overlap(lhs[1], rhs[1]) or _paths_overlap(lhs[1], rhs[0]):
+                    deps.add(j)
+            dependencies.append(deps)
+
+        return dependencies
+
+    def _submit_ready_steps(self):
+        for i in sorted(self._remaining):
+            if len(self._running) >= self._jobs:
+                break
+
+            # a step is ready only once all steps it depends on have finished, not merely started
+            if not self._dependencies[i] <= self._finished:
+                continue
+
+            _, _, task, arguments = self._steps[i]
+            _arguments = dict(arguments)
+            if isinstance(_arguments.get('analysis_file'), eos.AnalysisFile):
+                # the worker processes reload the analysis file, including any custom observables
+                _arguments['analysis_file'] = _arguments['analysis_file'].analysis_file
+
+            self._running[self._pool.submit(_run_step, task, _arguments)] = i
+            self._remaining.discard(i)
+
+    def run(self):
+        if self._dry_run:
+            return
+
+        threads = max(1, (os.cpu_count() or 1) // self._jobs)
+        # use fresh processes rather than forks, since forks do not inherit the threads of EOS' thread pool
+        self._pool = concurrent.futures.ProcessPoolExecutor(max_workers=self._jobs,
+                                                            mp_context=multiprocessing.get_context('spawn'),
+                                                            initializer=_initialize_worker,
+                                                            initargs=(threads, eos.logger.getEffectiveLevel()))
+        self._submit_ready_steps()
+
+    def join(self):
+        if self._dry_run:
+            for i, (name, desc, task, arguments) in enumerate(self._steps):
+                dependencies = ' '.join(str(j) for j in sorted(self._dependencies[i]))
+                print(f'[{i}] eos-analysis {task} {arguments} (depends on: {dependencies or "none"})')
+            return
+
+        try:
+            while self._running:
+                done, _ = concurrent.futures.wait(self._running.keys(), return_when=concurrent.futures.FIRST_COMPLETED)
+                for future in done:
+                    i = self._running.pop(future)
+                    name, _, task, arguments = self._steps[i]
+                    exception = future.exception()
+                    if exception is not None:
+                        eos.error(f'Task "{task}" in step "{name}" failed: {exception}')
+                        if self._exception is None:
+                            self._exception = exception
+                    else:
+                        self._finished.add(i)
+
+                # stop scheduling further steps after the first failure, but let the running steps finish
+                if self._exception is None:
+                    self._submit_ready_steps()
+        finally:
+            self._pool.shutdown(wait=True)
+
+        if self._exception is not None:
+            raise self._exception
+
+Executor.register('parallel', ParallelExecutor)
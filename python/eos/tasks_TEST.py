@@ -0,0 +1,97 @@
+import concurrent.futures
+import tempfile
+import threading
+import time
+import unittest
+import unittest.mock
+
+import eos
+import eos.tasks
+
+# dummy tasks that record when they start and finish, with the same path declarations as the chain
+# sample-mcmc -> find-clusters -> sample-pmc
+_events = []
+_events_lock = threading.Lock()
+
+def _record(name, delay):
+    with _events_lock:
+        _events.append(('start', name))
+    time.sleep(delay)
+    with _events_lock:
+        _events.append(('finish', name))
+
+@eos.tasks.task('test-mcmc', '{posterior}/mcmc-{chain:04}', inputs=lambda **kwargs: [])
+def _test_mcmc(posterior:str, chain:int, base_directory:str='./'):
+    _record(f'{posterior}/mcmc-{chain}', 0.2)
+
+@eos.tasks.task('test-clusters', '{posterior}/clusters', inputs=lambda posterior, **kwargs: [f'{posterior}/mcmc-*'])
+def _test_clusters(posterior:str, base_directory:str='./'):
+    _record('clusters', 0.1)
+
+@eos.tasks.task('test-pmc', '{posterior}/pmc', inputs=lambda posterior, **kwargs: [f'{posterior}/clusters'],
+                outputs=lambda posterior, **kwargs: [f'{posterior}/samples'])
+def _test_pmc(posterior:str, base_directory:str='./'):
+    _record('pmc', 0.1)
+
+@eos.tasks.task('test-predict', '{posterior}/pred', inputs=lambda posterior, **kwargs: [f'{posterior}/samples'])
+def _test_predict(posterior:str, base_directory:str='./'):
+    _record('predict', 0.0)
+
+@eos.tasks.task('test-barrier', 'barrier')
+def _test_barrier(base_directory:str='./'):
+    _record('barrier', 0.1)
+
+
+def _thread_pool(max_workers, **kwargs):
+    # the dummy tasks are only registered within this process
+    return concurrent.futures.ThreadPoolExecutor(max_workers=max_workers)
+
+
+class ParallelExecutorTests(unittest.TestCase):
+
+    def run_steps(self, steps):
+        _events.clear()
+        with tempfile.TemporaryDirectory() as base_directory:
+            steps = [(f'step-{i}', '', task, dict(arguments, base_directory=base_directory)) for i, (task, arguments) in enumerate(steps)]
+            with unittest.mock.patch('concurrent.futures.ProcessPoolExecutor', _thread_pool):
+                executor = eos.tasks.ParallelExecutor(steps, jobs=4)
+                executor.run()
+                executor.join()
+
+        return list(_events)
+
+    def assertFinishedBefore(self, events, first, second):
+        self.assertLess(events.index(('finish', first)), events.index(('start', second)),
+                        f'{second} started before {first} finished')
+
+    def test_dependency_chain(self):
+        events = self.run_steps([
+            ('test-mcmc',     { 'posterior': 'P', 'chain': 0 }),
+            ('test-mcmc',     { 'posterior': 'P', 'chain': 1 }),
+            ('test-clusters', { 'posterior': 'P' }),
+            ('test-pmc',      { 'posterior': 'P' }),
+            ('test-predict',  { 'posterior': 'P' }),
+        ])
+
+        self.assertEqual(len(events), 10)
+        # both chains run concurrently
+        self.assertLess(events.index(('start', 'P/mcmc-1')), events.index(('finish', 'P/mcmc-0')))
+        # every other step waits for its producers
+        self.assertFinishedBefore(events, 'P/mcmc-0', 'clusters')
+        self.assertFinishedBefore(events, 'P/mcmc-1', 'clusters')
+        self.assertFinishedBefore(events, 'clusters', 'pmc')
+        self.assertFinishedBefore(events, 'pmc', 'predict')
+
+    def test_barrier(self):
+        events = self.run_steps([
+            ('test-mcmc',    { 'posterior': 'P', 'chain': 0 }),
+            ('test-barrier', {}),
+            ('test-mcmc',    { 'posterior': 'Q', 'chain': 0 }),
+        ])
+
+        self.assertEqual(len(events), 6)
+        self.assertFinishedBefore(events, 'P/mcmc-0', 'barrier')
+        self.assertFinishedBefore(events, 'barrier', 'Q/mcmc-0')
+
+if __name__ == '__main__':
+    unittest.main(verbosity=5)
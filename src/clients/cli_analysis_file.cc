@@ -0,0 +1,187 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2026 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "cli_analysis_file.hh"
+
+#include <config.h>
+#include <eos/constraint.hh>
+#include <eos/observable.hh>
+#include <eos/statistics/log-likelihood.hh>
+#include <eos/statistics/log-posterior.hh>
+#include <eos/statistics/log-prior.hh>
+#include <eos/utils/parameters.hh>
+#include <eos/utils/units.hh>
+
+#include <yaml-cpp/yaml.h>
+
+#include <memory>
+
+namespace eos
+{
+    namespace cli
+    {
+        AnalysisFileError::AnalysisFileError(const std::string & message) noexcept :
+            Exception("Error handling analysis file: " + message)
+        {
+        }
+
+        namespace
+        {
+            // Find a named entry in a sequence of maps within an analysis file
+            YAML::Node find_named_entry(const YAML::Node & root, const std::string & key, const std::string & name)
+            {
+                if (! root[key].IsSequence())
+                    throw AnalysisFileError("Analysis file does not contain a sequence of " + key);
+
+                for (const auto & entry : root[key])
+                {
+                    if (entry["name"] && (entry["name"].as<std::string>() == name))
+                        return entry;
+                }
+
+                throw AnalysisFileError("Analysis file does not contain an entry '" + name + "' within " + key);
+            }
+        }
+
+        LogPosteriorPtr
+        make_log_posterior(const std::string & analysis_file, const std::string & posterior_name)
+        {
+            YAML::Node root;
+            try
+            {
+                root = YAML::LoadFile(analysis_file);
+            }
+            catch (YAML::Exception & e)
+            {
+                throw AnalysisFileError("Cannot load analysis file '" + analysis_file + "': " + e.what());
+            }
+
+            const YAML::Node posterior = find_named_entry(root, "posteriors", posterior_name);
+
+            // insert custom observables
+            for (const auto & o : root["observables"])
+            {
+                Options options;
+                for (const auto & option : o.second["options"])
+                {
+                    options.declare(option.first.as<std::string>(), option.second.as<std::string>());
+                }
+
+                Observables().insert(o.first.as<std::string>(), o.second["latex"].as<std::string>(), Unit(o.second["unit"].as<std::string>()),
+                        options, o.second["expression"].as<std::string>());
+            }
+
+            Parameters parameters = Parameters::Defaults();
+
+            Options global_options;
+            for (const auto & option : posterior["global_options"])
+            {
+                global_options.declare(option.first.as<std::string>(), option.second.as<std::string>());
+            }
+
+            for (const auto & p : posterior["fixed_parameters"])
+            {
+                parameters.set(p.first.as<std::string>(), p.second.as<double>());
+            }
+
+            // create the likelihood
+            LogLikelihood log_likelihood(parameters);
+            for (const auto & lh_name : posterior["likelihood"])
+            {
+                const YAML::Node lh = find_named_entry(root, "likelihoods", lh_name.as<std::string>());
+
+                for (const auto & c : lh["constraints"])
+                {
+                    log_likelihood.add(Constraint::make(c.as<std::string>(), global_options));
+                }
+
+                for (const auto & mc : lh["manual_constraints"])
+                {
+                    const QualifiedName name(mc.first.as<std::string>());
+                    std::unique_ptr<ConstraintEntry> entry(ConstraintEntry::FromYAML(name, mc.second));
+                    log_likelihood.add(entry->make(name, global_options));
+                }
+            }
+
+            // create the priors
+            LogPosteriorPtr log_posterior(new LogPosterior(log_likelihood));
+            for (const auto & prior_name : posterior["prior"])
+            {
+                const YAML::Node prior = find_named_entry(root, "priors", prior_name.as<std::string>());
+                const YAML::Node descriptions = prior["descriptions"] ? prior["descriptions"] : prior["parameters"];
+
+                for (const auto & d : descriptions)
+                {
+                    if (d["constraint"])
+                    {
+                        const QualifiedName name(d["constraint"].as<std::string>());
+                        auto entry = Constraints()[name];
+                        if (! entry)
+                            throw UnknownConstraintError(name);
+
+                        log_posterior->add(entry->make_prior(parameters, name.options()), false);
+
+                        continue;
+                    }
+
+                    const std::string name = d["parameter"].as<std::string>();
+                    const double min = d["min"].as<double>();
+                    const double max = d["max"].as<double>();
+                    const std::string type = d["type"] ? d["type"].as<std::string>() : "uniform";
+
+                    if (("uniform" == type) || ("flat" == type))
+                    {
+                        log_posterior->add(LogPrior::Flat(parameters, name, ParameterRange{ min, max }), false);
+                    }
+                    else if (("gauss" == type) || ("gaussian" == type))
+                    {
+                        const double central = d["central"].as<double>();
+                        double sigma_lo, sigma_hi;
+                        if (d["sigma"].IsSequence())
+                        {
+                            sigma_lo = d["sigma"][0].as<double>();
+                            sigma_hi = d["sigma"][1].as<double>();
+                        }
+                        else
+                        {
+                            sigma_lo = sigma_hi = d["sigma"].as<double>();
+                        }
+
+                        log_posterior->add(LogPrior::CurtailedGauss(parameters, name, ParameterRange{ min, max },
+                                central - sigma_lo, central, central + sigma_hi), false);
+                    }
+                    else if ("scale" == type)
+                    {
+                        log_posterior->add(LogPrior::Scale(parameters, name, ParameterRange{ min, max },
+                                d["mu_0"].as<double>(), d["lambda"].as<double>()), false);
+                    }
+                    else
+                    {
+                        throw AnalysisFileError("Unknown prior type '" + type + "'");
+                    }
+
+                    parameters[name].set_min(min);
+                    parameters[name].set_max(max);
+                }
+            }
+
+            return log_posterior;
+        }
+    }
+}
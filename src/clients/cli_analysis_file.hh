@@ -0,0 +1,58 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2026 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_SRC_CLIENTS_CLI_ANALYSIS_FILE_HH
+#define EOS_GUARD_SRC_CLIENTS_CLI_ANALYSIS_FILE_HH 1
+
+#include <eos/statistics/log-posterior-fwd.hh>
+#include <eos/utils/exception.hh>
+
+#include <string>
+
+namespace eos
+{
+    namespace cli
+    {
+        /**
+         * Thrown if an analysis file cannot be loaded or lacks a requested entry.
+         */
+        class AnalysisFileError :
+            public eos::Exception
+        {
+            public:
+                /**
+                 * Constructor.
+                 */
+                AnalysisFileError(const std::string & message) noexcept;
+        };
+
+        /**
+         * Create a named posterior from an analysis file.
+         *
+         * Inserts the analysis file's custom observables, and creates the posterior's
+         * likelihood and priors from the named entries of the analysis file.
+         *
+         * @param analysis_file The name of the analysis file.
+         * @param posterior     The name of the posterior within the analysis file.
+         */
+        LogPosteriorPtr make_log_posterior(const std::string & analysis_file, const std::string & posterior);
+    }
+}
+
+#endif
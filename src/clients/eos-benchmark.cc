@@ -0,0 +1,719 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2021 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "cli_analysis_file.hh"
+
+#include <config.h>
+#include <eos/observable.hh>
+#include <eos/statistics/log-posterior.hh>
+#include <eos/utils/destringify.hh>
+#include <eos/utils/instantiation_policy-impl.hh>
+#include <eos/utils/log.hh>
+#include <eos/utils/observable_cache.hh>
+#include <eos/utils/parameters.hh>
+#include <eos/utils/thread_pool.hh>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <set>
+#include <sstream>
+#include <vector>
+
+using namespace eos;
+
+class DoUsage
+{
+    private:
+        std::string _what;
+
+    public:
+        DoUsage(const std::string & what) :
+            _what(what)
+        {
+        }
+
+        const std::string & what() const
+        {
+            return _what;
+        }
+};
+
+using Clock = std::chrono::steady_clock;
+
+double seconds(const Clock::duration & d)
+{
+    return std::chrono::duration<double>(d).count();
+}
+
+/*
+ * A benchmark target is an independent context in which a set of observables or a posterior
+ * is evaluated. Parameter points are specified in the unit hypercube, and mapped onto the
+ * parameters by the target.
+ */
+class BenchmarkTarget
+{
+    public:
+        virtual ~BenchmarkTarget() = default;
+
+        /// The number of varied parameters.
+        virtual unsigned dimension() const = 0;
+
+        /// Move to a parameter point, given as one value within [0, 1) per varied parameter.
+        virtual void set(const double * u) = 0;
+
+        /// Evaluate the target at the current parameter point.
+        virtual double evaluate() = 0;
+
+        /// Create an independent copy of this target.
+        virtual std::shared_ptr<BenchmarkTarget> clone() const = 0;
+};
+
+using BenchmarkTargetPtr = std::shared_ptr<BenchmarkTarget>;
+
+// Evaluates a set of observables through an ObservableCache
+class ObservablesTarget :
+    public BenchmarkTarget
+{
+    private:
+        Parameters _parameters;
+
+        ObservableCache _cache;
+
+        std::vector<Parameter> _varied_parameters;
+
+    public:
+        ObservablesTarget(const Parameters & parameters, const ObservableCache & cache, const std::vector<Parameter::Id> & ids) :
+            _parameters(parameters),
+            _cache(cache)
+        {
+            for (const auto & id : ids)
+            {
+                _varied_parameters.push_back(_parameters[id]);
+            }
+        }
+
+        virtual unsigned dimension() const
+        {
+            return _varied_parameters.size();
+        }
+
+        virtual void set(const double * u)
+        {
+            for (unsigned i = 0 ; i < _varied_parameters.size() ; ++i)
+            {
+                auto & p = _varied_parameters[i];
+                p.set(p.min() + u[i] * (p.max() - p.min()));
+            }
+        }
+
+        virtual double evaluate()
+        {
+            _cache.update();
+
+            return _cache[0];
+        }
+
+        virtual BenchmarkTargetPtr clone() const
+        {
+            std::vector<Parameter::Id> ids;
+            for (const auto & p : _varied_parameters)
+            {
+                ids.push_back(p.id());
+            }
+
+            Parameters parameters = _parameters.clone();
+
+            return BenchmarkTargetPtr(new ObservablesTarget(parameters, _cache.clone(parameters), ids));
+        }
+};
+
+// Evaluates a posterior, mapping the unit hypercube onto the parameters via the inverse CDF of the priors
+class PosteriorTarget :
+    public BenchmarkTarget
+{
+    private:
+        LogPosteriorPtr _log_posterior;
+
+    public:
+        PosteriorTarget(const LogPosteriorPtr & log_posterior) :
+            _log_posterior(log_posterior)
+        {
+        }
+
+        virtual unsigned dimension() const
+        {
+            return _log_posterior->varied_parameters().size();
+        }
+
+        virtual void set(const double * u)
+        {
+            unsigned i = 0;
+            for (auto p : _log_posterior->varied_parameters())
+            {
+                p.set_generator(u[i++]);
+            }
+
+            for (auto p = _log_posterior->begin_priors(), p_end = _log_posterior->end_priors() ; p != p_end ; ++p)
+            {
+                (*p)->sample();
+            }
+        }
+
+        virtual double evaluate()
+        {
+            return _log_posterior->evaluate();
+        }
+
+        virtual BenchmarkTargetPtr clone() const
+        {
+            return BenchmarkTargetPtr(new PosteriorTarget(_log_posterior->clone()));
+        }
+};
+
+struct ObservableInput
+{
+    std::string name;
+
+    Kinematics kinematics;
+};
+
+class CommandLine :
+    public InstantiationPolicy<CommandLine, Singleton>
+{
+    public:
+        std::vector<ObservableInput> observable_inputs;
+
+        std::vector<std::string> varied_parameter_names;
+
+        std::string analysis_file;
+
+        std::string posterior;
+
+        std::string output;
+
+        unsigned points;
+
+        unsigned long seed;
+
+        CommandLine() :
+            points(100),
+            seed(17)
+        {
+        }
+
+        void parse(int argc, char ** argv)
+        {
+            Log::instance()->set_program_name("eos-benchmark");
+
+            ObservableInput observable_input;
+
+            for (char ** a(argv + 1), ** a_end(argv + argc) ; a != a_end ; ++a)
+            {
+                std::string argument(*a);
+
+                // all arguments take at least one value
+                if (a + 1 == a_end)
+                    throw DoUsage("Missing value for command line argument: " + argument);
+
+                if ("--kinematics" == argument)
+                {
+                    if (a + 2 == a_end)
+                        throw DoUsage("Missing value for command line argument: " + argument);
+
+                    std::string name = std::string(*(++a));
+                    double value = destringify<double>(*(++a));
+                    observable_input.kinematics.declare(name, value);
+
+                    continue;
+                }
+
+                if ("--observable" == argument)
+                {
+                    observable_input.name = std::string(*(++a));
+                    observable_inputs.push_back(observable_input);
+
+                    observable_input = ObservableInput();
+
+                    continue;
+                }
+
+                if ("--vary" == argument)
+                {
+                    varied_parameter_names.push_back(std::string(*(++a)));
+
+                    continue;
+                }
+
+                if ("--analysis-file" == argument)
+                {
+                    analysis_file = std::string(*(++a));
+
+                    continue;
+                }
+
+                if ("--posterior" == argument)
+                {
+                    posterior = std::string(*(++a));
+
+                    continue;
+                }
+
+                if ("--points" == argument)
+                {
+                    points = destringify<unsigned>(*(++a));
+
+                    continue;
+                }
+
+                if ("--seed" == argument)
+                {
+                    seed = destringify<unsigned long>(*(++a));
+
+                    continue;
+                }
+
+                if ("--output" == argument)
+                {
+                    output = std::string(*(++a));
+
+                    continue;
+                }
+
+                throw DoUsage("Unknown command line argument: " + argument);
+            }
+
+            if (observable_inputs.empty() && posterior.empty())
+                throw DoUsage("Neither observables nor a posterior specified");
+
+            if (! observable_inputs.empty() && ! posterior.empty())
+                throw DoUsage("Observables and a posterior are mutually exclusive");
+
+            if (! posterior.empty() && analysis_file.empty())
+                throw DoUsage("A posterior requires an analysis file");
+
+            if (! varied_parameter_names.empty() && ! posterior.empty())
+                throw DoUsage("The varied parameters of a posterior are determined by its priors");
+
+            if (0 == points)
+                throw DoUsage("The number of points must be positive");
+        }
+};
+
+// Create the target for a list of observables
+BenchmarkTargetPtr make_observables_target()
+{
+    auto command_line = CommandLine::instance();
+
+    Parameters parameters = Parameters::Defaults();
+    ObservableCache cache(parameters);
+
+    for (const auto & input : command_line->observable_inputs)
+    {
+        Kinematics kinematics = input.kinematics.clone();
+        ObservablePtr observable = Observable::make(input.name, parameters, kinematics, Options());
+        if (! observable)
+            throw DoUsage("Unknown observable '" + input.name + "'");
+
+        cache.add(observable);
+    }
+
+    // vary the requested parameters, or else all parameters that are used by the observables
+    std::vector<Parameter::Id> ids;
+    if (! command_line->varied_parameter_names.empty())
+    {
+        for (const auto & name : command_line->varied_parameter_names)
+        {
+            try
+            {
+                ids.push_back(parameters[name].id());
+            }
+            catch (UnknownParameterError & e)
+            {
+                throw DoUsage("Unknown parameter '" + name + "'");
+            }
+        }
+    }
+    else
+    {
+        std::set<Parameter::Id> used_ids;
+        for (auto o = cache.begin(), o_end = cache.end() ; o != o_end ; ++o)
+        {
+            used_ids.insert((*o)->begin(), (*o)->end());
+        }
+
+        ids.assign(used_ids.cbegin(), used_ids.cend());
+    }
+
+    return BenchmarkTargetPtr(new ObservablesTarget(parameters, cache, ids));
+}
+
+// Create the target for a named posterior from an analysis file
+BenchmarkTargetPtr make_posterior_target()
+{
+    auto command_line = CommandLine::instance();
+
+    return BenchmarkTargetPtr(new PosteriorTarget(cli::make_log_posterior(command_line->analysis_file, command_line->posterior)));
+}
+
+// Return the percentile of a sorted, non-empty sample, using linear interpolation between the closest ranks
+double percentile(const std::vector<double> & sorted, const double & p)
+{
+    const double x = p * (sorted.size() - 1);
+    const std::size_t i = std::min<std::size_t>(x, sorted.size() - 1);
+    const std::size_t j = std::min<std::size_t>(i + 1, sorted.size() - 1);
+
+    return sorted[i] + (x - i) * (sorted[j] - sorted[i]);
+}
+
+// Minimal JSON writer
+class JSONWriter
+{
+    private:
+        std::ostream & _os;
+
+        std::vector<bool> _first;
+
+        void _separate()
+        {
+            if (_first.empty())
+                return;
+
+            if (! _first.back())
+                _os << ',';
+
+            _first.back() = false;
+        }
+
+    public:
+        JSONWriter(std::ostream & os) :
+            _os(os)
+        {
+            _os << std::setprecision(9);
+        }
+
+        JSONWriter & begin_object() { _separate(); _os << '{'; _first.push_back(true); return *this; }
+        JSONWriter & end_object() { _first.pop_back(); _os << '}'; return *this; }
+        JSONWriter & begin_array() { _separate(); _os << '['; _first.push_back(true); return *this; }
+        JSONWriter & end_array() { _first.pop_back(); _os << ']'; return *this; }
+
+        JSONWriter & key(const std::string & k)
+        {
+            value(k);
+            _os << ':';
+            _first.back() = true;
+
+            return *this;
+        }
+
+        JSONWriter & value(const std::string & v)
+        {
+            _separate();
+            _os << '"';
+            for (const char & c : v)
+            {
+                switch (c)
+                {
+                    case '"':  _os << "\\\""; break;
+                    case '\\': _os << "\\\\"; break;
+                    case '\n': _os << "\\n";  break;
+                    case '\t': _os << "\\t";  break;
+                    default:
+                        if (static_cast<unsigned char>(c) < 0x20)
+                            _os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c) << std::dec << std::setfill(' ');
+                        else
+                            _os << c;
+                }
+            }
+            _os << '"';
+
+            return *this;
+        }
+
+        JSONWriter & value(const double & v)
+        {
+            _separate();
+            if (std::isfinite(v))
+                _os << v;
+            else
+                _os << "null";
+
+            return *this;
+        }
+
+        JSONWriter & value(const unsigned long & v)
+        {
+            _separate();
+            _os << v;
+
+            return *this;
+        }
+
+        template <typename T_>
+        JSONWriter & entry(const std::string & k, const T_ & v)
+        {
+            return key(k).value(v);
+        }
+};
+
+struct SteadyStateResult
+{
+    std::vector<double> times;
+
+    unsigned long failures = 0;
+
+    double total = 0.0;
+};
+
+// Evaluate the target at each point in turn, and time each evaluation
+SteadyStateResult steady_state(BenchmarkTarget & target, const std::vector<double> & points, const unsigned & n_points)
+{
+    SteadyStateResult result;
+    result.times.reserve(n_points);
+
+    const unsigned dimension = target.dimension();
+    for (unsigned i = 0 ; i < n_points ; ++i)
+    {
+        target.set(points.data() + i * dimension);
+
+        const auto start = Clock::now();
+        try
+        {
+            if (! std::isfinite(target.evaluate()))
+                ++result.failures;
+        }
+        catch (Exception & e)
+        {
+            ++result.failures;
+        }
+        result.times.push_back(seconds(Clock::now() - start));
+    }
+
+    result.total = std::accumulate(result.times.cbegin(), result.times.cend(), 0.0);
+    std::sort(result.times.begin(), result.times.end());
+
+    return result;
+}
+
+// Evaluate all points on a number of independent clones of the target, and return the wall time
+double concurrent_wall_time(const BenchmarkTarget & target, const std::vector<double> & points, const unsigned & n_points, const unsigned & n_threads)
+{
+    std::vector<BenchmarkTargetPtr> clones;
+    for (unsigned j = 0 ; j < n_threads ; ++j)
+    {
+        clones.push_back(target.clone());
+    }
+
+    const unsigned dimension = target.dimension();
+
+    const auto start = Clock::now();
+
+    TaskGroup tasks;
+    for (unsigned j = 0 ; j < n_threads ; ++j)
+    {
+        const unsigned begin = (j * n_points) / n_threads, end = ((j + 1) * n_points) / n_threads;
+
+        tasks.run([&clones, &points, dimension, j, begin, end] () {
+            auto & clone = *clones[j];
+            for (unsigned i = begin ; i < end ; ++i)
+            {
+                clone.set(points.data() + i * dimension);
+                try
+                {
+                    clone.evaluate();
+                }
+                catch (Exception & e)
+                {
+                    // failures are accounted for in the steady-state results
+                }
+            }
+        });
+    }
+    tasks.wait();
+
+    return seconds(Clock::now() - start);
+}
+
+int
+main(int argc, char * argv[])
+{
+    try
+    {
+        auto command_line = CommandLine::instance();
+        command_line->parse(argc, argv);
+
+        // cold construction
+        auto start = Clock::now();
+        BenchmarkTargetPtr target = command_line->posterior.empty() ? make_observables_target() : make_posterior_target();
+        const double construction_time = seconds(Clock::now() - start);
+
+        // first evaluation at the default parameter point
+        start = Clock::now();
+        double first_value = std::numeric_limits<double>::quiet_NaN();
+        try
+        {
+            first_value = target->evaluate();
+        }
+        catch (Exception & e)
+        {
+            Log::instance()->message("eos-benchmark", ll_warning)
+                << "First evaluation failed: " << e.what();
+        }
+        const double first_evaluation_time = seconds(Clock::now() - start);
+
+        // reproducible set of random points within the unit hypercube
+        const unsigned dimension = target->dimension();
+        const unsigned n_points = command_line->points;
+        std::mt19937_64 rng(command_line->seed);
+        std::vector<double> points(n_points * dimension);
+        for (auto & u : points)
+        {
+            // use the upper 53 bits, which is independent of the standard library's implementation of distributions
+            u = (rng() >> 11) * 0x1.0p-53;
+        }
+
+        // steady state
+        const SteadyStateResult steady = steady_state(*target, points, n_points);
+
+        // thread scaling, from one thread up to the number of threads in the pool
+        const unsigned max_threads = ThreadPool::instance()->number_of_threads();
+        std::vector<unsigned> thread_counts;
+        for (unsigned t = 1 ; t < max_threads ; t *= 2)
+        {
+            thread_counts.push_back(t);
+        }
+        thread_counts.push_back(max_threads);
+
+        std::vector<double> wall_times;
+        for (const auto & t : thread_counts)
+        {
+            wall_times.push_back(concurrent_wall_time(*target, points, n_points, t));
+        }
+
+        // emit the results
+        std::ofstream output_file;
+        if (! command_line->output.empty())
+        {
+            output_file.open(command_line->output);
+            if (! output_file)
+                throw DoUsage("Cannot open output file '" + command_line->output + "'");
+        }
+        std::ostream & os = command_line->output.empty() ? std::cout : output_file;
+
+        JSONWriter json(os);
+        json.begin_object();
+        json.entry("eos-version", std::string(PACKAGE_VERSION));
+        if (command_line->posterior.empty())
+        {
+            json.key("observables").begin_array();
+            for (const auto & input : command_line->observable_inputs)
+            {
+                json.begin_object()
+                    .entry("name", input.name)
+                    .entry("kinematics", input.kinematics.as_string())
+                    .end_object();
+            }
+            json.end_array();
+        }
+        else
+        {
+            json.entry("analysis-file", command_line->analysis_file);
+            json.entry("posterior", command_line->posterior);
+        }
+        json.entry("dimension", (unsigned long)dimension);
+        json.entry("points", (unsigned long)n_points);
+        json.entry("seed", command_line->seed);
+
+        json.key("construction").begin_object()
+            .entry("time", construction_time)
+            .end_object();
+
+        json.key("first-evaluation").begin_object()
+            .entry("time", first_evaluation_time)
+            .entry("value", first_value)
+            .end_object();
+
+        json.key("steady-state").begin_object()
+            .entry("evaluations", (unsigned long)n_points)
+            .entry("failures", steady.failures)
+            .entry("mean", steady.total / n_points)
+            .entry("min", steady.times.front())
+            .entry("p50", percentile(steady.times, 0.50))
+            .entry("p90", percentile(steady.times, 0.90))
+            .entry("p99", percentile(steady.times, 0.99))
+            .entry("max", steady.times.back())
+            .entry("evaluations-per-second", n_points / steady.total)
+            .end_object();
+
+        json.key("thread-scaling").begin_array();
+        for (unsigned k = 0 ; k < thread_counts.size() ; ++k)
+        {
+            const double speedup = wall_times.front() / wall_times[k];
+            json.begin_object()
+                .entry("threads", (unsigned long)thread_counts[k])
+                .entry("time", wall_times[k])
+                .entry("evaluations-per-second", n_points / wall_times[k])
+                .entry("speedup", speedup)
+                .entry("efficiency", speedup / thread_counts[k])
+                .end_object();
+        }
+        json.end_array();
+
+        json.end_object();
+        os << std::endl;
+    }
+    catch(DoUsage & e)
+    {
+        std::cout << e.what() << std::endl;
+        std::cout << "Usage: eos-benchmark" << std::endl;
+        std::cout << "  [--points N] [--seed SEED] [--output FILE]" << std::endl;
+        std::cout << "  {[[--kinematics NAME VALUE]* --observable OBSERVABLE]+ [--vary PARAMETER]*" << std::endl;
+        std::cout << "   |--analysis-file FILE --posterior POSTERIOR}" << std::endl;
+        std::cout << std::endl;
+        std::cout << "Times the cold construction, the first evaluation, and the steady-state evaluation" << std::endl;
+        std::cout << "of a set of observables or of a named posterior at reproducible random parameter points." << std::endl;
+        std::cout << "Observables are evaluated with all of their parameters varied within their ranges, unless" << std::endl;
+        std::cout << "--vary is specified. The thread scaling is measured up to EOS_MAX_THREADS threads." << std::endl;
+        std::cout << "The results are emitted in JSON format." << std::endl;
+        std::cout << std::endl;
+        std::cout << "Example:" << std::endl;
+        std::cout << "  eos-benchmark --points 1000 --kinematics q2 1.0 --observable \"B->pilnu::dBR/dq2;l=mu\"" << std::endl;
+        std::cout << "  eos-benchmark --analysis-file analysis.yaml --posterior CKM+FF" << std::endl;
+    }
+    catch(Exception & e)
+    {
+        std::cerr << "Caught exception: '" << e.what() << "'" << std::endl;
+        return EXIT_FAILURE;
+    }
+    catch(...)
+    {
+        std::cerr << "Aborting after unknown exception" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
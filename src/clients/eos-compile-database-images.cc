@@ -0,0 +1,134 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2026 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <eos/constraint.hh>
+#include <eos/utils/instantiation_policy-impl.hh>
+#include <eos/utils/log.hh>
+#include <eos/utils/parameters.hh>
+
+#include <iostream>
+#include <string>
+
+using namespace eos;
+
+class DoUsage
+{
+    private:
+        std::string _what;
+
+    public:
+        DoUsage(const std::string & what) :
+            _what(what)
+        {
+        }
+
+        const std::string & what() const
+        {
+            return _what;
+        }
+};
+
+class CommandLine :
+    public InstantiationPolicy<CommandLine, Singleton>
+{
+    public:
+        std::string parameters_image;
+
+        std::string constraints_image;
+
+        void parse(int argc, char ** argv)
+        {
+            Log::instance()->set_program_name("eos-compile-database-images");
+
+            for (char ** a(argv + 1), ** a_end(argv + argc) ; a != a_end ; ++a)
+            {
+                std::string argument(*a);
+
+                if ("--parameters" == argument)
+                {
+                    if (a_end == ++a)
+                        throw DoUsage("Missing file name after '--parameters'");
+
+                    parameters_image = std::string(*a);
+
+                    continue;
+                }
+
+                if ("--constraints" == argument)
+                {
+                    if (a_end == ++a)
+                        throw DoUsage("Missing file name after '--constraints'");
+
+                    constraints_image = std::string(*a);
+
+                    continue;
+                }
+
+                throw DoUsage("Unknown command line argument: " + argument);
+            }
+
+            if (parameters_image.empty() && constraints_image.empty())
+                throw DoUsage("Need at least one of '--parameters' or '--constraints'");
+        }
+};
+
+int
+main(int argc, char * argv[])
+{
+    try
+    {
+        CommandLine::instance()->parse(argc, argv);
+
+        if (! CommandLine::instance()->parameters_image.empty())
+        {
+            Parameters::compile_image(CommandLine::instance()->parameters_image);
+        }
+
+        if (! CommandLine::instance()->constraints_image.empty())
+        {
+            Constraints::compile_image(CommandLine::instance()->constraints_image);
+        }
+    }
+    catch(DoUsage & e)
+    {
+        std::cout << e.what() << std::endl;
+        std::cout << "Usage: eos-compile-database-images" << std::endl;
+        std::cout << "  [--parameters FILE]" << std::endl;
+        std::cout << "  [--constraints FILE]" << std::endl;
+
+        std::cout << "Compile the parameter and/or the constraint input files into binary database images." << std::endl;
+        std::cout << "EOS loads the images 'parameters.eosdb' and 'constraints.eosdb' from the respective" << std::endl;
+        std::cout << "directories of the input files in place of the input files, as long as the latter" << std::endl;
+        std::cout << "remain unchanged." << std::endl;
+
+        return EXIT_FAILURE;
+    }
+    catch(Exception & e)
+    {
+        std::cerr << "Caught exception: '" << e.what() << "'" << std::endl;
+        return EXIT_FAILURE;
+    }
+    catch(...)
+    {
+        std::cerr << "Aborting after unknown exception" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
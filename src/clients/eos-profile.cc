@@ -0,0 +1,249 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2026 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "cli_analysis_file.hh"
+
+#include <config.h>
+#include <eos/statistics/log-posterior.hh>
+#include <eos/statistics/profile-likelihood-scan.hh>
+#include <eos/utils/destringify.hh>
+#include <eos/utils/instantiation_policy-impl.hh>
+#include <eos/utils/log.hh>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace eos;
+
+class DoUsage
+{
+    private:
+        std::string _what;
+
+    public:
+        DoUsage(const std::string & what) :
+            _what(what)
+        {
+        }
+
+        const std::string & what() const
+        {
+            return _what;
+        }
+};
+
+class CommandLine :
+    public InstantiationPolicy<CommandLine, Singleton>
+{
+    public:
+        std::vector<ProfileLikelihoodScan::Axis> axes;
+
+        ProfileLikelihoodScan::Config config;
+
+        std::string analysis_file;
+
+        std::string posterior;
+
+        std::string output;
+
+        CommandLine() :
+            config(ProfileLikelihoodScan::Config::Default())
+        {
+        }
+
+        void parse(int argc, char ** argv)
+        {
+            Log::instance()->set_program_name("eos-profile");
+
+            for (char ** a(argv + 1), ** a_end(argv + argc) ; a != a_end ; ++a)
+            {
+                std::string argument(*a);
+
+                // all arguments take at least one value
+                if (a + 1 == a_end)
+                    throw DoUsage("Missing value for command line argument: " + argument);
+
+                if ("--scan" == argument)
+                {
+                    if (a + 4 >= a_end)
+                        throw DoUsage("Missing value for command line argument: " + argument);
+
+                    std::string name = std::string(*(++a));
+                    unsigned points = destringify<unsigned>(*(++a));
+                    double min = destringify<double>(*(++a));
+                    double max = destringify<double>(*(++a));
+                    axes.push_back(ProfileLikelihoodScan::Axis{ name, min, max, points });
+
+                    continue;
+                }
+
+                if ("--analysis-file" == argument)
+                {
+                    analysis_file = std::string(*(++a));
+
+                    continue;
+                }
+
+                if ("--posterior" == argument)
+                {
+                    posterior = std::string(*(++a));
+
+                    continue;
+                }
+
+                if ("--max-iterations" == argument)
+                {
+                    config.max_iterations = destringify<unsigned>(*(++a));
+
+                    continue;
+                }
+
+                if ("--tolerance" == argument)
+                {
+                    config.tolerance = destringify<double>(*(++a));
+
+                    continue;
+                }
+
+                if ("--output" == argument)
+                {
+                    output = std::string(*(++a));
+
+                    continue;
+                }
+
+                throw DoUsage("Unknown command line argument: " + argument);
+            }
+
+            if (analysis_file.empty() || posterior.empty())
+                throw DoUsage("Need an analysis file and a posterior");
+
+            if (axes.empty() || (axes.size() > 2))
+                throw DoUsage("Need one or two scan parameters");
+
+            for (const auto & axis : axes)
+            {
+                if (0 == axis.points)
+                    throw DoUsage("The number of points of scan parameter '" + axis.name + "' must be positive");
+            }
+        }
+};
+
+int
+main(int argc, char * argv[])
+{
+    try
+    {
+        auto command_line = CommandLine::instance();
+        command_line->parse(argc, argv);
+
+        LogPosteriorPtr log_posterior = cli::make_log_posterior(command_line->analysis_file, command_line->posterior);
+
+        ProfileLikelihoodScan scan(*log_posterior, command_line->axes, command_line->config);
+        scan.run();
+
+        // emit the results
+        std::ofstream output_file;
+        if (! command_line->output.empty())
+        {
+            output_file.open(command_line->output);
+            if (! output_file)
+                throw DoUsage("Cannot open output file '" + command_line->output + "'");
+        }
+        std::ostream & os = command_line->output.empty() ? std::cout : output_file;
+
+        const auto & log_posterior_values = scan.log_posterior_values();
+        const double max_log_posterior = *std::max_element(log_posterior_values.cbegin(), log_posterior_values.cend());
+
+        const std::vector<std::string> profiled_names = scan.profiled_parameter_names();
+        const unsigned n_axes = command_line->axes.size(), n_profiled = profiled_names.size();
+
+        os << "# Generated by eos-profile (" EOS_GITHEAD ")" << std::endl;
+        os << "# Analysis file: " << command_line->analysis_file << ", posterior: " << command_line->posterior << std::endl;
+        os << "# Scan data" << std::endl;
+        for (const auto & axis : command_line->axes)
+        {
+            os << "#   " << axis.name << ": [" << axis.min << ", " << axis.max << "], points = " << axis.points << std::endl;
+        }
+        os << "# Columns" << std::endl;
+        for (const auto & axis : command_line->axes)
+        {
+            os << "#   " << axis.name << std::endl;
+        }
+        for (const auto & name : profiled_names)
+        {
+            os << "#   " << name << " (profiled)" << std::endl;
+        }
+        os << "#   log(posterior)" << std::endl;
+        os << "#   log(likelihood)" << std::endl;
+        os << "#   -2 * (log(posterior) - max. log(posterior))" << std::endl;
+
+        os << std::scientific << std::setprecision(7);
+        for (unsigned n = 0 ; n < scan.number_of_points() ; ++n)
+        {
+            for (unsigned k = 0 ; k < n_axes ; ++k)
+            {
+                os << scan.points()[n * n_axes + k] << '\t';
+            }
+
+            for (unsigned k = 0 ; k < n_profiled ; ++k)
+            {
+                os << scan.profiled_values()[n * n_profiled + k] << '\t';
+            }
+
+            os << log_posterior_values[n] << '\t'
+               << scan.log_likelihood_values()[n] << '\t'
+               << -2.0 * (log_posterior_values[n] - max_log_posterior) << std::endl;
+        }
+    }
+    catch(DoUsage & e)
+    {
+        std::cout << e.what() << std::endl;
+        std::cout << "Usage: eos-profile" << std::endl;
+        std::cout << "  --analysis-file FILE --posterior POSTERIOR" << std::endl;
+        std::cout << "  [--scan PARAMETER POINTS MIN MAX]{1,2}" << std::endl;
+        std::cout << "  [--max-iterations N] [--tolerance TOLERANCE] [--output FILE]" << std::endl;
+        std::cout << std::endl;
+        std::cout << "Scans the profile of a named posterior on a grid in one or two parameters of interest." << std::endl;
+        std::cout << "At each grid point, the log(posterior) is maximised with respect to all other varied parameters." << std::endl;
+        std::cout << "Each axis comprises POINTS equidistant values, including MIN and MAX. The grid points are" << std::endl;
+        std::cout << "distributed across up to EOS_MAX_THREADS threads." << std::endl;
+        std::cout << std::endl;
+        std::cout << "Example:" << std::endl;
+        std::cout << "  eos-profile --analysis-file analysis.yaml --posterior WET \\" << std::endl;
+        std::cout << "      --scan \"b->smumu::Re{c9}\" 41 2.0 6.0 --scan \"b->smumu::Re{c10}\" 41 -6.0 -2.0" << std::endl;
+    }
+    catch(Exception & e)
+    {
+        std::cerr << "Caught exception: '" << e.what() << "'" << std::endl;
+        return EXIT_FAILURE;
+    }
+    catch(...)
+    {
+        std::cerr << "Aborting after unknown exception" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}